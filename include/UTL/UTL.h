@@ -6,6 +6,12 @@
 #include "UTL_common.h"
 #include "UTL_string.h"
 #include "UTL_list.h"
+#include "UTL_soalist.h"
+#include "UTL_queue.h"
+#include "UTL_priorityqueue.h"
+#include "UTL_bitset.h"
+#include "UTL_slotmap.h"
+#include "UTL_jobs.h"
 #include "UTL_set.h"
 #include "UTL_map.h"
 #include "UTL_config.h"
@@ -0,0 +1,91 @@
+#ifndef UTL_BITSET_H
+#define UTL_BITSET_H
+
+
+
+#include "UTL/UTL.h"
+
+
+
+/** set of bits with a dynamic size, one bit of memory per flag */
+typedef struct {
+    const int numBits;  // number of bits in the set
+} UTL_BitSet;
+
+
+
+// bitset functions ///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** set the bit at index @bit. bits out of bounds are ignored */
+extern void UTL_BitSetSet(UTL_BitSet *set, int bit);
+
+
+/** clear the bit at index @bit. bits out of bounds are ignored */
+extern void UTL_BitSetClear(UTL_BitSet *set, int bit);
+
+
+/** is the bit at index @bit set? false for bits out of bounds */
+extern bool UTL_BitSetTest(UTL_BitSet *set, int bit);
+
+
+/** set all bits */
+extern void UTL_BitSetSetAll(UTL_BitSet *set);
+
+
+/** clear all bits */
+extern void UTL_BitSetClearAll(UTL_BitSet *set);
+
+
+/** change the number of bits of the set, added bits are cleared */
+extern void UTL_BitSetResize(UTL_BitSet *set, int numBits);
+
+
+/** number of set bits */
+extern int UTL_BitSetCount(UTL_BitSet *set);
+
+
+/** index of the first set bit, -1 if no bit is set */
+extern int UTL_BitSetFindFirst(UTL_BitSet *set);
+
+
+/** index of the first set bit behind @bit, -1 if there is none
+ *
+ *  for (int bit = UTL_BitSetFindFirst(set); bit >= 0; bit = UTL_BitSetFindNext(set, bit))
+ *      visit(bit); */
+extern int UTL_BitSetFindNext(UTL_BitSet *set, int bit);
+
+
+// bitwise operations between bitsets. @dst keeps its size: bits of @src beyond it are ignored,
+// and bits of @dst beyond the size of @src are combined with cleared bits
+
+
+/** @dst = @dst & @src */
+extern void UTL_BitSetAnd(UTL_BitSet *dst, UTL_BitSet *src);
+
+
+/** @dst = @dst | @src */
+extern void UTL_BitSetOr(UTL_BitSet *dst, UTL_BitSet *src);
+
+
+/** @dst = @dst ^ @src */
+extern void UTL_BitSetXor(UTL_BitSet *dst, UTL_BitSet *src);
+
+
+/** @dst = @dst & ~@src, clears the bits of @dst set in @src */
+extern void UTL_BitSetAndNot(UTL_BitSet *dst, UTL_BitSet *src);
+
+
+// bitset constructors ////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new bitset of @numBits cleared bits */
+extern UTL_BitSet* UTL_BitSetCreate(int numBits);
+
+
+/** free the memory associated with the given bitset */
+extern void UTL_BitSetDestroy(UTL_BitSet *set);
+
+
+
+#endif // UTL_BITSET_H
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <limits.h>
 
 
 
@@ -42,6 +43,29 @@ extern const UTL_TypeInfo UTL_TypeInfoChar;
 extern const UTL_TypeInfo UTL_TypeInfoFloat;
 
 
+
+/** a run of @count objects, the first at @ptr and each following one @stride bytes behind the previous */
+typedef struct {
+    void   *ptr;     /** first object of the run */
+    int     count;   /** number of objects in the run */
+    size_t  stride;  /** distance in bytes from one object to the next */
+} UTL_Span;
+
+
+/** number of logical processors of this machine */
+extern int UTL_NumProcessors(void);
+
+/** monotonic time in nanoseconds, for measuring durations */
+extern long long UTL_TimeNs(void);
+
+/** map a whole file into memory read only, NULL if it can't be opened or is empty */
+extern void* UTL_MapFile(const char *path, size_t *size);
+
+/** release a mapping returned by UTL_MapFile() */
+extern void UTL_UnmapFile(void *ptr, size_t size);
+
+
+
 // encode a value into the bits of a pointer
 #define UTL_ToPtr(type, val) (((union { type x; void *y; }) { .x = val}).y)
 
@@ -0,0 +1,72 @@
+#ifndef UTL_JOBS_H
+#define UTL_JOBS_H
+
+
+
+#include "UTL/UTL.h"
+
+
+
+/** function run by a job: func(aux) */
+typedef void (UTL_JobFunc)(void*);
+
+/** function run on a range of indices by a parallel for: func(aux, first, last) visits [first, last) */
+typedef void (UTL_JobRangeFunc)(void*, int, int);
+
+
+
+/** handle to a job, see UTL_JobsRun() */
+typedef struct UTL_Job UTL_Job;
+
+
+
+/** job system, running jobs on a pool of worker threads which steal jobs from each other when they run out */
+typedef struct {
+    const int numWorkers;  // number of worker threads
+} UTL_Jobs;
+
+
+
+// job functions //////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** run func(@aux) as a job on the workers, once the @numDeps jobs at @deps have finished.
+ *  a job with a @parent counts as part of it: the parent job only finishes once all of its children have.
+ *  @parent must not have finished yet, it usually is the job calling this.
+ *  returns a handle to the new job, to be passed to either UTL_JobsWait() or UTL_JobRelease() */
+extern UTL_Job* UTL_JobsRun(UTL_Jobs *jobs, UTL_JobFunc *func, void *aux, UTL_Job *parent, UTL_Job * const *deps, int numDeps);
+
+
+/** wait for a job and all of its children to finish and release its handle.
+ *  the waiting thread runs pending jobs in the meantime, so jobs may wait for other jobs */
+extern void UTL_JobsWait(UTL_Jobs *jobs, UTL_Job *job);
+
+
+/** call func(@aux, first, last) for consecutive ranges covering [0, @count) on the workers and wait for all of them.
+ *  ranges are split in halves as long as other workers are idle, down to @grainSize indices -- or down to a size
+ *  derived from @count and the number of workers if @grainSize is not positive */
+extern void UTL_JobsParallelFor(UTL_Jobs *jobs, int count, UTL_JobRangeFunc *func, void *aux, int grainSize);
+
+
+/** has the job and all of its children finished? */
+extern bool UTL_JobIsDone(UTL_Job *job);
+
+
+/** release the handle of a job without waiting for it, the job still runs */
+extern void UTL_JobRelease(UTL_Job *job);
+
+
+// job system constructors ////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** Create a new job system
+ *  @numWorkers: number of worker threads, one per processor if not positive */
+extern UTL_Jobs* UTL_JobsCreate(int numWorkers);
+
+
+/** stop the workers and free the memory associated with the given job system. all jobs must have finished */
+extern void UTL_JobsDestroy(UTL_Jobs *jobs);
+
+
+
+#endif // UTL_JOBS_H
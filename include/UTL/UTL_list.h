@@ -9,8 +9,11 @@
 
 /** different types of lists  */
 typedef enum {
-    UTL_ARRAY_LIST,  // list backed by an array
-    UTL_LINKED_LIST  // list backed by linked nodes
+    UTL_ARRAY_LIST,    // list backed by an array
+    UTL_LINKED_LIST,   // list backed by linked nodes
+    UTL_UNROLLED_LIST, // list backed by linked chunks of objects
+    UTL_DEQUE_LIST,    // list backed by a circular buffer, O(1) push and pop at both ends
+    UTL_TREE_LIST      // list backed by a B+tree, O(log n) indexed access, insert and remove
 } UTL_ListType;
 
 
@@ -25,15 +28,55 @@ typedef struct {
 
 
 
+/** allocator for the nodes of linked lists, can be shared by lists storing objects of the same size */
+typedef struct UTL_ListNodePool UTL_ListNodePool;
+
+
+
 /** abstract base type for all list iterators */
 typedef struct {
-    UTL_List *list;     // the list into which this iterator is pointing
-    void     *auxData;  // for internal use -- don't use
-    int       index;    // index into the list
+    UTL_List *list;      // the list into which this iterator is pointing
+    void     *auxData;   // for internal use -- don't use
+    int       auxIndex;  // for internal use -- don't use
+    int       index;     // index into the list
 } UTL_ListIter;
 
 
 
+/** iterator over the runs of objects a list stores contiguously, see UTL_ListGetSpanIter() */
+typedef struct {
+    UTL_List *list;     // the list whose objects are visited
+    void     *auxData;  // for internal use -- don't use
+    int       index;    // index of the first object of @span
+    UTL_Span  span;     // the current run of objects
+} UTL_ListSpanIter;
+
+
+
+/** progress of an incremental operation on a list, see UTL_ListSortIncremental().
+ *  zero initialize it before the first step. after the operation completed, it can be used for another one */
+typedef struct {
+    void *auxData;  // for internal use -- don't use
+    int   steps;    // number of steps done so far
+} UTL_ListIncremental;
+
+
+
+/** immutable copy of the objects of a list, see UTL_ListFreeze(). snapshots are reference counted and can be read
+ *  by any number of threads at once without locking. for lists storing objects by reference only the pointers are
+ *  copied, the objects they point at are not protected */
+typedef struct {
+    const UTL_TypeInfo * const dataType;  // type of the contained data
+    const bool                 byRef;     // objects stored by pointer or by value?
+    const int                  count;     // number of objects in the snapshot
+} UTL_ListSnapshot;
+
+
+/** holds the current snapshot a writer published for readers on other threads, see UTL_ListSnapshotPublish() */
+typedef struct UTL_ListSnapshotSlot UTL_ListSnapshotSlot;
+
+
+
 // abstract list functions ////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -66,7 +109,7 @@ extern void UTL_ListPushBack(UTL_List *list, void *obj);
 extern void UTL_ListPushFront(UTL_List *list, void *obj);
 
 
-/** append a new object to the back of the list */
+/** insert a new object at index @at, moving the objects from there on back by one */
 extern void UTL_ListInsert(UTL_List *list, int at, void *obj);
 
 
@@ -82,29 +125,203 @@ extern void UTL_ListPopFront(UTL_List *list);
 extern void UTL_ListRemove(UTL_List *list, int at);
 
 
-/** find the first index of the given object, at or after @offset */
+/** make room for at least @capacity objects, so that pushing up to that many objects does not reallocate.
+ *  only array and deque lists keep their objects in one buffer, other list types ignore this */
+extern void UTL_ListReserve(UTL_List *list, int capacity);
+
+
+/** release the unused capacity of array and deque lists */
+extern void UTL_ListShrinkToFit(UTL_List *list);
+
+
+/** fraction of the links between neighbouring objects of a linked list that do not join adjacent nodes in memory:
+ *  0 for lists built by pushing to the back or compacted lists, close to 1 if the nodes are scattered across the heap.
+ *  always 0 for other list types */
+extern float UTL_ListFragmentation(UTL_List *list);
+
+
+/** move the nodes of a linked list into one block of memory in list order, so iterating it touches memory
+ *  sequentially again. only compacts if UTL_ListFragmentation() is above @threshold, a negative @threshold always
+ *  compacts. returns true if the list was compacted. other list types are left alone and return false */
+extern bool UTL_ListCompact(UTL_List *list, float threshold);
+
+
+/** compact a linked list like UTL_ListCompact() over several calls, moving up to @maxSteps nodes per call and
+ *  stopping after about @budgetNs nanoseconds -- no limit if not positive. between calls the list stays valid and can
+ *  be read, but must not be modified until the operation completed or was cancelled.
+ *  returns true once the list is compacted, other list types complete at once */
+extern bool UTL_ListCompactIncremental(UTL_List *list, UTL_ListIncremental *op, int maxSteps, long long budgetNs);
+
+
+/** append @n objects to the back of the list.
+ *  @objs points to @n consecutive objects, or to @n consecutive object pointers for lists storing objects by reference */
+extern void UTL_ListPushBackN(UTL_List *list, const void *objs, int n);
+
+
+/** insert @n objects at index @at, moving the objects from there on back by @n.
+ *  see UTL_ListPushBackN() for the layout of @objs, which must not point into the list itself */
+extern void UTL_ListInsertRange(UTL_List *list, int at, const void *objs, int n);
+
+
+/** remove @n objects starting at index @at from the list. the range is clipped to the list */
+extern void UTL_ListRemoveRange(UTL_List *list, int at, int n);
+
+
+/** append all objects of @other to the back of @list. appending a list to itself doubles it */
+extern void UTL_ListAppendList(UTL_List *list, UTL_List *other);
+
+
+/** remove all objects for which @predFunc(@aux, obj) returns true, in a single pass over the list.
+ *  the remaining objects keep their order. returns the number of removed objects */
+extern int UTL_ListRemoveIf(UTL_List *list, bool (*predFunc)(void*,void*), void *aux);
+
+
+/** keep only the objects for which @predFunc(@aux, obj) returns true, see UTL_ListRemoveIf() */
+extern int UTL_ListRetainIf(UTL_List *list, bool (*predFunc)(void*,void*), void *aux);
+
+
+/** reduce every run of adjacent objects comparing equal to its first object, using the compare function
+ *  of the list's data type. sort the list first to remove all duplicates. returns the number of removed objects */
+extern int UTL_ListUnique(UTL_List *list);
+
+
+/** find the first index of the given object, at or after @offset. returns -1 if there is none.
+ *  objects are compared with the compare function of the list's data type if it has one, otherwise
+ *  objects stored by reference are compared by address and objects stored by value byte by byte.
+ *  array lists of int, float or char stored by value are searched with SIMD instructions */
 extern int UTL_ListFindFirst(UTL_List *list, void *obj, int offset);
 
 
-/** find the last index of the given object, at or before @offset */
+/** find the last index of the given object, at or before @offset. see UTL_ListFindFirst() */
 extern int UTL_ListFindLast(UTL_List *list, void *obj, int offset);
 
 
-/** */
+/** return true if the list contains the given object, see UTL_ListFindFirst() */
 extern bool UTL_ListContains(UTL_List *list, void *obj);
 
 
-/** sort a list */
+/** sort a list using the compare function of its data type.
+ *  array lists of int, float or char stored by value are radix sorted, other array lists use pattern-defeating quicksort.
+ *  linked lists are merge sorted by relinking their nodes */
 extern void UTL_ListSort(UTL_List *list);
 
 
+/** sort a list, keeping objects that compare equal in their original order */
+extern void UTL_ListSortStable(UTL_List *list);
+
+
+/** sort a list on @numThreads threads, or on all processors if @numThreads is not positive.
+ *  array lists are sorted in parallel runs which are merged in parallel, the result is not stable.
+ *  small lists and other list types are sorted on the calling thread, see UTL_ListSort() */
+extern void UTL_ListSortParallel(UTL_List *list, int numThreads);
+
+
+/** sort a list over several calls, doing up to @maxSteps steps of about one comparison per call and stopping after
+ *  about @budgetNs nanoseconds -- no limit if not positive. the objects are swapped in place by an introsort which can pause after
+ *  any comparison, so between calls the list holds all of its objects and can be read, but must not be modified
+ *  until the operation completed or was cancelled. the result is not stable. returns true once the list is sorted
+ *
+ *  UTL_ListIncremental op = { 0 };
+ *  while (!UTL_ListSortIncremental(list, &op, 0, 2000000))
+ *      renderFrame(); */
+extern bool UTL_ListSortIncremental(UTL_List *list, UTL_ListIncremental *op, int maxSteps, long long budgetNs);
+
+
+/** stop an incremental operation before it completed, see UTL_ListSortIncremental(). the list stays valid */
+extern void UTL_ListIncrementalCancel(UTL_ListIncremental *op);
+
+
 /** return true if the given list is sorted */
 extern bool UTL_ListIsSorted(UTL_List *list);
 
 
+/** index of the first object of a sorted list that is not ordered before @obj, or the list's count if there is none.
+ *  returns -1 if the list's data type has no compare function. array, deque and tree lists are binary searched,
+ *  by value arrays of int or float with a branchless search prefetching the next probes of large arrays */
+extern int UTL_ListLowerBound(UTL_List *list, void *obj);
+
+
+/** index of the first object of a sorted list that is ordered after @obj, see UTL_ListLowerBound() */
+extern int UTL_ListUpperBound(UTL_List *list, void *obj);
+
+
+/** index of the first object of a sorted list comparing equal to @obj, or -1 if there is none */
+extern int UTL_ListBinarySearch(UTL_List *list, void *obj);
+
+
+/** insert @obj into a sorted list behind all objects comparing equal to it, so the list stays sorted.
+ *  returns the index of the inserted object, or -1 without inserting if the list's data type has no compare function */
+extern int UTL_ListInsertSorted(UTL_List *list, void *obj);
+
+
+/** append the objects of two sorted lists to @dst in sorted order, see UTL_ListMergeSortedK() */
+extern void UTL_ListMergeSorted(UTL_List *dst, UTL_List *list1, UTL_List *list2);
+
+
+/** append the objects of @numLists sorted lists to @dst in sorted order, using the compare function of @dst's
+ *  data type. objects comparing equal keep the order of their lists. @dst must not be one of the merged lists */
+extern void UTL_ListMergeSortedK(UTL_List *dst, UTL_List **lists, int numLists);
+
+
+/** sum of all objects of an int or float list, 0 for lists of other types.
+ *  lists storing objects by value are summed span by span with SIMD instructions, ints exactly and floats in single precision lanes */
+extern double UTL_ListSum(UTL_List *list);
+
+
+/** sum of all objects of an int or float list like UTL_ListSum(), but floats are summed pairwise:
+ *  the rounding error grows with the logarithm of the list size instead of linearly */
+extern double UTL_ListSumPairwise(UTL_List *list);
+
+
+/** copy the smallest object of a list to @min, see UTL_ListMinMax() */
+extern bool UTL_ListMin(UTL_List *list, void *min);
+
+
+/** copy the largest object of a list to @max, see UTL_ListMinMax() */
+extern bool UTL_ListMax(UTL_List *list, void *max);
+
+
+/** copy the smallest and the largest object of a list to @min and @max, either of which may be NULL.
+ *  objects are compared with the compare function of the list's data type, NaNs in float lists are skipped.
+ *  returns false without copying anything if the list is empty or its data type has no compare function */
+extern bool UTL_ListMinMax(UTL_List *list, void *min, void *max);
+
+
+/** dot product of two int or two float lists, over as many objects as the shorter list has.
+ *  returns 0 for lists of other or different types */
+extern double UTL_ListDot(UTL_List *list1, UTL_List *list2);
+
+
+/** multiply every object of an int or float list by @factor, ints are truncated toward zero and become INT_MIN
+ *  if the product is out of the range of int or NaN. lists of other types are left alone */
+extern void UTL_ListScale(UTL_List *list, double factor);
+
+
 extern void* UTL_ListFold(UTL_List *list, void* (*foldFunc)(void*,void*), void *state);
 
 
+/** call forEachFunc(@aux, obj) for every object of the list on @numThreads threads, or on all processors if
+ *  @numThreads is not positive. every thread visits an equally sized range of indices, walking the list span by span.
+ *  lists with fewer than a few thousand objects per thread use fewer threads, down to just the calling thread.
+ *  the callbacks of the parallel functions run concurrently, they may change objects but must not insert or remove any */
+extern void UTL_ListParallelForEach(UTL_List *list, void (*forEachFunc)(void*,void*), void *aux, int numThreads);
+
+
+/** append the results of mapFunc(@aux, dstObj, obj) for every object of @src to @dst, computed on @numThreads threads.
+ *  @mapFunc writes its result to dstObj, which points at an object of @dst's data type -- or at an object pointer
+ *  if @dst stores objects by reference. @dst must not be @src, see UTL_ListParallelForEach() */
+extern void UTL_ListParallelMap(UTL_List *dst, UTL_List *src, void (*mapFunc)(void*,void*,void*), void *aux, int numThreads);
+
+
+/** reduce all objects of the list into @result on @numThreads threads, see UTL_ListParallelForEach().
+ *  @result holds a state of @stateSize bytes, initially the neutral element of @combineFunc (e.g. 0 for a sum).
+ *  every thread starts with a copy of it and calls reduceFunc(@aux, state, obj) for the objects of its range,
+ *  afterwards the states are combined in list order with combineFunc(@aux, result, state), which has to be associative */
+extern void UTL_ListParallelReduce(UTL_List *list, void *result, size_t stateSize,
+                                   void (*reduceFunc)(void*,void*,void*), void (*combineFunc)(void*,void*,void*),
+                                   void *aux, int numThreads);
+
+
 /** get an iterator to the beginning of the list */
 extern UTL_ListIter UTL_ListGetIteratorFront(UTL_List *list);
 
@@ -141,12 +358,103 @@ extern void* UTL_ListIterGet(UTL_ListIter *iter);
 extern void UTL_ListIterSet(UTL_ListIter *iter, void *obj);
 
 
+/** insert a new object in front of the object the iterator points at. the iterator keeps pointing at the same object */
 extern void UTL_ListIterInsert(UTL_ListIter *iter, void *obj);
 
 
+/** remove the object the iterator points at. the iterator moves on to the following object */
 extern void UTL_ListIterRemove(UTL_ListIter *iter);
 
 
+// list spans /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** get an iterator over the contiguous runs of objects of a list, in list order: one span for array lists,
+ *  up to two for deque lists, one per chunk or leaf of unrolled and tree lists, and one per node of linked lists,
+ *  where nodes allocated one after another from the same pool are joined into one span with the node size as stride.
+ *  spans of lists storing objects by reference contain the object pointers.
+ *  the spans stay valid until the list is modified
+ *
+ *  for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter))
+ *      for (int i = 0; i < iter.span.count; i++)
+ *          sum += *(int*) ((char*) iter.span.ptr + i * iter.span.stride); */
+extern UTL_ListSpanIter UTL_ListGetSpanIter(UTL_List *list);
+
+
+extern bool UTL_ListSpanIterIsValid(UTL_ListSpanIter *iter);
+
+
+extern void UTL_ListSpanIterNext(UTL_ListSpanIter *iter);
+
+
+/** copy up to @maxSpans spans of a list to @spans, see UTL_ListGetSpanIter().
+ *  returns the number of spans of the whole list, which may be more than @maxSpans */
+extern int UTL_ListGetSpans(UTL_List *list, UTL_Span *spans, int maxSpans);
+
+
+// list files /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** write the objects of a list storing objects by value to the file at @path, see UTL_ListMapFile().
+ *  the file holds a small header (object size, count, type name and checksum) followed by the raw objects,
+ *  and can be read on machines with the same byte order and type layout.
+ *  returns false if the list stores objects by reference or the file can't be written */
+extern bool UTL_ListSave(UTL_List *list, const char *path);
+
+
+// list snapshots /////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** copy the objects of a list into a new immutable snapshot, allocated as a single block of exactly the needed size.
+ *  the caller holds the only reference to it
+ *
+ *  // writer, once per frame
+ *  UTL_ListSnapshotPublish(slot, UTL_ListFreeze(list));
+ *
+ *  // reader on another thread
+ *  UTL_ListSnapshot *snapshot = UTL_ListSnapshotPin(slot);
+ *  for (int i = 0; snapshot && i < snapshot->count; i++)
+ *      draw(UTL_ListSnapshotGet(snapshot, i));
+ *  if (snapshot) UTL_ListSnapshotRelease(snapshot); */
+extern UTL_ListSnapshot* UTL_ListFreeze(UTL_List *list);
+
+
+/** the object at index @at of the snapshot, NULL if out of bounds */
+extern const void* UTL_ListSnapshotGet(const UTL_ListSnapshot *snapshot, int at);
+
+
+/** span over all objects of the snapshot, which lie one after another. the objects must not be changed */
+extern UTL_Span UTL_ListSnapshotGetSpan(const UTL_ListSnapshot *snapshot);
+
+
+/** take another reference to a snapshot */
+extern void UTL_ListSnapshotRetain(UTL_ListSnapshot *snapshot);
+
+
+/** drop a reference to a snapshot, the last one frees it */
+extern void UTL_ListSnapshotRelease(UTL_ListSnapshot *snapshot);
+
+
+/** make @snapshot the current snapshot of the slot, taking over the caller's reference to it. publishers are
+ *  serialized by a mutex, readers are never blocked. the replaced snapshot is retired and released as soon as no
+ *  reader is in the middle of pinning, readers which already pinned it keep it alive until they release it */
+extern void UTL_ListSnapshotPublish(UTL_ListSnapshotSlot *slot, UTL_ListSnapshot *snapshot);
+
+
+/** take a reference to the current snapshot of the slot without locking, NULL if nothing was published yet.
+ *  the caller releases it with UTL_ListSnapshotRelease() */
+extern UTL_ListSnapshot* UTL_ListSnapshotPin(UTL_ListSnapshotSlot *slot);
+
+
+/** create a new slot for publishing snapshots, holding none yet */
+extern UTL_ListSnapshotSlot* UTL_ListSnapshotSlotCreate(void);
+
+
+/** free a slot and drop its references to the current and retired snapshots. no reader may be pinning anymore,
+ *  snapshots pinned earlier stay valid until they are released */
+extern void UTL_ListSnapshotSlotDestroy(UTL_ListSnapshotSlot *slot);
+
+
 // list constructors //////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -157,6 +465,287 @@ extern void UTL_ListIterRemove(UTL_ListIter *iter);
 extern UTL_List* UTL_ListCreate(UTL_ListType listType, const UTL_TypeInfo *dataType, bool byRef);
 
 
+/** create a pool of nodes, that can be shared by linked lists storing objects of the given type.
+ *  nodes are allocated in slabs and recycled through a free list, so pushing and removing never calls malloc/free.
+ *  the pool stays alive until it was destroyed and all lists using it were destroyed. pools are not thread-safe */
+extern UTL_ListNodePool* UTL_ListNodePoolCreate(const UTL_TypeInfo *dataType, bool byRef);
+
+
+/** release the handle to a node pool returned by UTL_ListNodePoolCreate() */
+extern void UTL_ListNodePoolDestroy(UTL_ListNodePool *pool);
+
+
+/** create a new linked list, allocating its nodes from a shared @pool.
+ *  linked lists created with UTL_ListCreate() use a private pool, which is freed as a whole on destruction.
+ *  returns NULL if the pool was created for objects of a different size */
+extern UTL_List* UTL_ListCreateWithPool(const UTL_TypeInfo *dataType, bool byRef, UTL_ListNodePool *pool);
+
+
+/** create a new array list with an inline buffer for @inlineCapacity objects, allocated together with the list.
+ *  small lists need a single allocation and keep their objects next to the list header. when the list outgrows
+ *  the inline buffer the objects move to the heap, and UTL_ListShrinkToFit() moves them back once they fit again */
+extern UTL_List* UTL_ListCreateWithInlineBuffer(const UTL_TypeInfo *dataType, bool byRef, int inlineCapacity);
+
+
+/** create an array list of the objects in a file written by UTL_ListSave(), backed directly by a read only mapping of
+ *  the file. loading takes constant time, pages are read when first touched and don't count against the commit limit.
+ *  the list is meant to be read: before it is first changed, all of its objects are copied to the heap. objects must not
+ *  be written through pointers returned by UTL_ListGet(), iterators or spans while the list is still mapped.
+ *  returns NULL if the file can't be mapped or holds objects of another type, or if @verify is set and the checksum of
+ *  the objects does not match, which reads the whole file */
+extern UTL_List* UTL_ListMapFile(const char *path, const UTL_TypeInfo *dataType, bool verify);
+
+
+
+
+// type specialized lists ///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** generate a list type @Name holding objects of type @T directly by value.
+ *  the generated functions mirror the abstract list functions (Name_PushBack, Name_Get, Name_GetIteratorFront, ...),
+ *  but are monomorphic: objects are passed and returned as @T, copies are plain assignments and everything is inlined.
+ *  to store objects by reference, use a pointer type for @T.
+ *  unlike UTL_ListGet, Name_Get returns the object itself, so @at has to be a valid index -- use Name_GetPtr to check.
+ *
+ *  UTL_LIST_DEFINE(IntList, int)
+ *
+ *  IntList *list = IntList_Create();
+ *  IntList_PushBack(list, 42);
+ *  int i = IntList_Get(list, 0);
+ *  IntList_Destroy(list); */
+#define UTL_LIST_DEFINE(Name, T)                                                                                       \
+                                                                                                                       \
+typedef struct {                                                                                                       \
+    int  count;     /* number of objects currently in the list */                                                      \
+    int  capacity;  /* maximum number of objects that could be stored without relocation */                           \
+    T   *data;      /* array containing all objects, allocated on first push */                                        \
+} Name;                                                                                                                \
+                                                                                                                       \
+typedef struct {                                                                                                       \
+    Name *list;   /* the list into which this iterator is pointing */                                                  \
+    int   index;  /* index into the list */                                                                            \
+} Name##Iter;                                                                                                          \
+                                                                                                                       \
+static inline Name* Name##_Create(void) {                                                                              \
+    Name *list = (Name*) malloc(sizeof(Name));                                                                         \
+    list->count    = 0;                                                                                                \
+    list->capacity = 0;                                                                                                \
+    list->data     = NULL;                                                                                             \
+    return list;                                                                                                       \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_Destroy(Name *list) {                                                                        \
+    free(list->data);                                                                                                  \
+    free(list);                                                                                                        \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_Reserve(Name *list, int minCapacity) {                                                       \
+    if (minCapacity <= list->capacity) return;                                                                         \
+    int capacity = list->capacity ? list->capacity : UTL_LIST_DEFINE_INITIAL_CAPACITY;                                 \
+    while (capacity < minCapacity) capacity += capacity >> 1;                                                          \
+    list->data     = (T*) realloc(list->data, sizeof(T) * capacity);                                                   \
+    list->capacity = capacity;                                                                                         \
+}                                                                                                                      \
+                                                                                                                       \
+static inline T Name##_Get(Name *list, int at) {                                                                       \
+    return list->data[at];                                                                                             \
+}                                                                                                                      \
+                                                                                                                       \
+static inline T* Name##_GetPtr(Name *list, int at) {                                                                   \
+    if (at < 0 || at >= list->count) return NULL;                                                                      \
+    return list->data + at;                                                                                            \
+}                                                                                                                      \
+                                                                                                                       \
+static inline T Name##_GetBack(Name *list) {                                                                           \
+    return list->data[list->count - 1];                                                                                \
+}                                                                                                                      \
+                                                                                                                       \
+static inline T Name##_GetFront(Name *list) {                                                                          \
+    return list->data[0];                                                                                              \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_Set(Name *list, int at, T obj) {                                                             \
+    if (at < 0 || at >= list->count) return;                                                                          \
+    list->data[at] = obj;                                                                                              \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_PushBack(Name *list, T obj) {                                                                \
+    if (list->count == list->capacity) Name##_Reserve(list, list->count + 1);                                          \
+    list->data[list->count++] = obj;                                                                                   \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_Insert(Name *list, int at, T obj) {                                                          \
+    if (at < 0) at = 0;                                                                                                \
+    if (at > list->count) at = list->count;                                                                            \
+    if (list->count == list->capacity) Name##_Reserve(list, list->count + 1);                                          \
+    memmove(list->data + at + 1, list->data + at, sizeof(T) * (list->count - at));                                     \
+    list->data[at] = obj;                                                                                              \
+    list->count++;                                                                                                     \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_PushFront(Name *list, T obj) {                                                               \
+    Name##_Insert(list, 0, obj);                                                                                       \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_Remove(Name *list, int at) {                                                                 \
+    if (at < 0 || at >= list->count) return;                                                                           \
+    memmove(list->data + at, list->data + at + 1, sizeof(T) * (list->count - at - 1));                                 \
+    list->count--;                                                                                                     \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_PopBack(Name *list) {                                                                        \
+    if (list->count) list->count--;                                                                                    \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_PopFront(Name *list) {                                                                       \
+    Name##_Remove(list, 0);                                                                                            \
+}                                                                                                                      \
+                                                                                                                       \
+static inline Name##Iter Name##_GetIteratorAt(Name *list, int at) {                                                    \
+    if (at < 0) at = list->count + at;                                                                                 \
+    if (at < 0 || at >= list->count) return (Name##Iter) { .list = NULL, .index = 0 };                                 \
+    return (Name##Iter) { .list = list, .index = at };                                                                 \
+}                                                                                                                      \
+                                                                                                                       \
+static inline Name##Iter Name##_GetIteratorFront(Name *list) {                                                         \
+    return Name##_GetIteratorAt(list, 0);                                                                              \
+}                                                                                                                      \
+                                                                                                                       \
+static inline Name##Iter Name##_GetIteratorBack(Name *list) {                                                          \
+    return Name##_GetIteratorAt(list, -1);                                                                             \
+}                                                                                                                      \
+                                                                                                                       \
+static inline bool Name##_IterIsValid(Name##Iter *iter) {                                                              \
+    return iter->list != NULL && iter->index >= 0 && iter->index < iter->list->count;                                  \
+}                                                                                                                      \
+                                                                                                                       \
+static inline bool Name##_IterHasNext(Name##Iter *iter) {                                                              \
+    return iter->list != NULL && iter->index < iter->list->count - 1;                                                  \
+}                                                                                                                      \
+                                                                                                                       \
+static inline bool Name##_IterHasPrev(Name##Iter *iter) {                                                              \
+    return iter->list != NULL && iter->index > 0;                                                                      \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_IterNext(Name##Iter *iter) {                                                                 \
+    if (Name##_IterIsValid(iter)) iter->index++;                                                                       \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_IterPrev(Name##Iter *iter) {                                                                 \
+    if (Name##_IterIsValid(iter)) iter->index--;                                                                       \
+}                                                                                                                      \
+                                                                                                                       \
+static inline T Name##_IterGet(Name##Iter *iter) {                                                                     \
+    return iter->list->data[iter->index];                                                                              \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_IterSet(Name##Iter *iter, T obj) {                                                           \
+    if (Name##_IterIsValid(iter)) iter->list->data[iter->index] = obj;                                                 \
+}
+
+
+/** generate search and sort functions for a list type generated with UTL_LIST_DEFINE(@Name, @T).
+ *  @CMP is a function or function-like macro comparing two objects of type @T by value,
+ *  returning a negative value, zero or a positive value (like UTL_TypeInfo.cmpFunc) -- it is inlined into the sort.
+ *
+ *  #define IntCmp(a, b) (((a) > (b)) - ((a) < (b)))
+ *  UTL_LIST_DEFINE_CMP(IntList, int, IntCmp)
+ *
+ *  IntList_Sort(list); */
+#define UTL_LIST_DEFINE_CMP(Name, T, CMP)                                                                              \
+                                                                                                                       \
+static inline int Name##_FindFirst(Name *list, T obj, int offset) {                                                    \
+    for (int i = offset < 0 ? 0 : offset; i < list->count; i++)                                                       \
+        if (CMP(list->data[i], obj) == 0) return i;                                                                    \
+    return -1;                                                                                                         \
+}                                                                                                                      \
+                                                                                                                       \
+static inline int Name##_FindLast(Name *list, T obj, int offset) {                                                     \
+    for (int i = offset >= list->count ? list->count - 1 : offset; i >= 0; i--)                                        \
+        if (CMP(list->data[i], obj) == 0) return i;                                                                    \
+    return -1;                                                                                                         \
+}                                                                                                                      \
+                                                                                                                       \
+static inline bool Name##_Contains(Name *list, T obj) {                                                                \
+    return Name##_FindFirst(list, obj, 0) >= 0;                                                                        \
+}                                                                                                                      \
+                                                                                                                       \
+static inline bool Name##_IsSorted(Name *list) {                                                                       \
+    for (int i = 1; i < list->count; i++)                                                                              \
+        if (CMP(list->data[i], list->data[i-1]) < 0) return false;                                                     \
+    return true;                                                                                                       \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_SiftDown_(T *data, int root, int n) {                                                        \
+    T obj = data[root];                                                                                                \
+    for (int child = 2 * root + 1; child < n; child = 2 * root + 1) {                                                  \
+        if (child + 1 < n && CMP(data[child], data[child + 1]) < 0) child++;                                           \
+        if (CMP(obj, data[child]) >= 0) break;                                                                         \
+        data[root] = data[child];                                                                                      \
+        root = child;                                                                                                  \
+    }                                                                                                                  \
+    data[root] = obj;                                                                                                  \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_InsertionSort_(T *data, int n) {                                                             \
+    for (int i = 1; i < n; i++) {                                                                                      \
+        T obj = data[i];                                                                                               \
+        int j = i;                                                                                                     \
+        while (j > 0 && CMP(obj, data[j-1]) < 0) { data[j] = data[j-1]; j--; }                                         \
+        data[j] = obj;                                                                                                 \
+    }                                                                                                                  \
+}                                                                                                                      \
+                                                                                                                       \
+static void Name##_SortRange_(T *data, int n, int depthLimit) {                                                        \
+    while (n > UTL_LIST_DEFINE_INSERTION_SORT_THRESHOLD) {                                                             \
+        /* too many bad partitions -> heap sort the rest */                                                            \
+        if (depthLimit-- == 0) {                                                                                       \
+            for (int i = n / 2 - 1; i >= 0; i--) Name##_SiftDown_(data, i, n);                                         \
+            for (int i = n - 1; i > 0; i--) {                                                                          \
+                T tmp = data[0]; data[0] = data[i]; data[i] = tmp;                                                     \
+                Name##_SiftDown_(data, 0, i);                                                                          \
+            }                                                                                                          \
+            return;                                                                                                    \
+        }                                                                                                              \
+                                                                                                                       \
+        /* median of three, pivot ends up in the middle */                                                             \
+        int mid = n / 2;                                                                                               \
+        T tmp;                                                                                                         \
+        if (CMP(data[mid], data[0]) < 0)       { tmp = data[mid]; data[mid] = data[0];   data[0]   = tmp; }            \
+        if (CMP(data[n-1], data[0]) < 0)       { tmp = data[n-1]; data[n-1] = data[0];   data[0]   = tmp; }            \
+        if (CMP(data[n-1], data[mid]) < 0)     { tmp = data[n-1]; data[n-1] = data[mid]; data[mid] = tmp; }            \
+        T pivot = data[mid];                                                                                           \
+                                                                                                                       \
+        /* hoare partition into [0, j] and [j+1, n) */                                                                 \
+        int i = -1, j = n;                                                                                             \
+        while (true) {                                                                                                 \
+            do i++; while (CMP(data[i], pivot) < 0);                                                                   \
+            do j--; while (CMP(pivot, data[j]) < 0);                                                                   \
+            if (i >= j) break;                                                                                         \
+            tmp = data[i]; data[i] = data[j]; data[j] = tmp;                                                           \
+        }                                                                                                              \
+                                                                                                                       \
+        /* recurse into the smaller part, loop on the bigger one */                                                    \
+        if (j + 1 < n - j - 1) { Name##_SortRange_(data, j + 1, depthLimit); data += j + 1; n -= j + 1; }              \
+        else                   { Name##_SortRange_(data + j + 1, n - j - 1, depthLimit); n = j + 1; }                  \
+    }                                                                                                                  \
+    Name##_InsertionSort_(data, n);                                                                                    \
+}                                                                                                                      \
+                                                                                                                       \
+static inline void Name##_Sort(Name *list) {                                                                           \
+    int depthLimit = 0;                                                                                                \
+    for (int n = list->count; n > 1; n >>= 1) depthLimit += 2;                                                         \
+    Name##_SortRange_(list->data, list->count, depthLimit);                                                            \
+}
+
+
+/** initial capacity of lists generated with UTL_LIST_DEFINE */
+#define UTL_LIST_DEFINE_INITIAL_CAPACITY 64
+
+/** ranges up to this size are sorted with insertion sort by lists generated with UTL_LIST_DEFINE_CMP */
+#define UTL_LIST_DEFINE_INSERTION_SORT_THRESHOLD 16
+
+
 
 
 #endif // UTL_LIST_H
@@ -0,0 +1,80 @@
+#ifndef UTL_PRIORITYQUEUE_H
+#define UTL_PRIORITYQUEUE_H
+
+
+
+#include "UTL/UTL.h"
+
+
+
+/** priority queue, popping objects smallest first as ordered by the compare function of their type.
+ *  every pushed object gets a handle, which stays valid until the object is popped or removed */
+typedef struct {
+    const UTL_TypeInfo * const dataType;  // type of the contained data
+    const bool                 byRef;     // are objects in this queue stored by pointer, or directly by value
+    const int                  count;     // number of objects currently in the queue
+} UTL_PriorityQueue;
+
+
+
+// priority queue functions ///////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** add an object to the queue. returns the handle of the object, handles of popped or removed objects are reused */
+extern int UTL_PriorityQueuePush(UTL_PriorityQueue *queue, void *obj);
+
+
+/** the smallest object of the queue, NULL if the queue is empty */
+extern void* UTL_PriorityQueuePeek(UTL_PriorityQueue *queue);
+
+
+/** handle of the smallest object of the queue, -1 if the queue is empty */
+extern int UTL_PriorityQueuePeekHandle(UTL_PriorityQueue *queue);
+
+
+/** remove the smallest object from the queue, copying it to @obj unless it is NULL -- or storing the object pointer
+ *  at @obj for queues storing objects by reference. returns false if the queue is empty */
+extern bool UTL_PriorityQueuePop(UTL_PriorityQueue *queue, void *obj);
+
+
+/** the object with the given handle, NULL if the handle is not in the queue */
+extern void* UTL_PriorityQueueGet(UTL_PriorityQueue *queue, int handle);
+
+
+/** is the object with the given handle in the queue? */
+extern bool UTL_PriorityQueueContains(UTL_PriorityQueue *queue, int handle);
+
+
+/** replace the object with the given handle by @obj, moving it to its new place in the queue.
+ *  O(log n) -- a decrease key if @obj is smaller than the replaced object. returns false if the handle is not in the queue */
+extern bool UTL_PriorityQueueUpdate(UTL_PriorityQueue *queue, int handle, void *obj);
+
+
+/** remove the object with the given handle from the queue. returns false if the handle is not in the queue */
+extern bool UTL_PriorityQueueRemove(UTL_PriorityQueue *queue, int handle);
+
+
+/** remove all objects from the queue, keeping its memory */
+extern void UTL_PriorityQueueClear(UTL_PriorityQueue *queue);
+
+
+// priority queue constructors ////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** Create a new priority queue
+ *  @dataType: what type of objects are stored, ordered by its compare function
+ *  @byRef: true of objects are stored by pointer, false if they are stored directly by value */
+extern UTL_PriorityQueue* UTL_PriorityQueueCreate(const UTL_TypeInfo *dataType, bool byRef);
+
+
+/** create a new priority queue holding all objects of a list, stored like in the list. O(n).
+ *  the object at index i of the list gets the handle i */
+extern UTL_PriorityQueue* UTL_PriorityQueueCreateFromList(UTL_List *list);
+
+
+/** free the memory associated with the given priority queue */
+extern void UTL_PriorityQueueDestroy(UTL_PriorityQueue *queue);
+
+
+
+#endif // UTL_PRIORITYQUEUE_H
@@ -0,0 +1,61 @@
+#ifndef UTL_QUEUE_H
+#define UTL_QUEUE_H
+
+
+
+#include "UTL/UTL.h"
+
+
+
+/** bounded multi producer, multi consumer queue, safe to push and pop from any number of threads without locks */
+typedef struct {
+    const UTL_TypeInfo * const dataType;  // type of the contained data
+    const bool                 byRef;     // are objects in this queue stored by pointer, or directly by value
+    const int                  capacity;  // maximum number of objects in the queue, a power of two
+} UTL_Queue;
+
+
+
+// queue functions ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** push an object to the back of the queue. returns false without pushing if the queue is full */
+extern bool UTL_QueueTryPush(UTL_Queue *queue, void *obj);
+
+
+/** pop the object at the front of the queue, copying it to @obj -- or storing the object pointer at @obj
+ *  for queues storing objects by reference. returns false if the queue is empty */
+extern bool UTL_QueueTryPop(UTL_Queue *queue, void *obj);
+
+
+/** push up to @n objects to the back of the queue, as many as fit at once, keeping them together in the queue.
+ *  @objs points to @n consecutive objects, or to @n consecutive object pointers for queues storing objects by reference.
+ *  returns the number of pushed objects, which are the first ones of @objs */
+extern int UTL_QueueTryPushN(UTL_Queue *queue, const void *objs, int n);
+
+
+/** pop up to @n objects from the front of the queue into @objs, see UTL_QueueTryPushN().
+ *  returns the number of popped objects, 0 if the queue is empty */
+extern int UTL_QueueTryPopN(UTL_Queue *queue, void *objs, int n);
+
+
+/** number of objects in the queue. only a snapshot while other threads push or pop */
+extern int UTL_QueueCount(UTL_Queue *queue);
+
+
+// queue constructors /////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** Create a new queue
+ *  @dataType: what type of objects are stored
+ *  @byRef: true of objects are stored by pointer, false if they are stored directly by value
+ *  @capacity: maximum number of objects in the queue, rounded up to a power of two */
+extern UTL_Queue* UTL_QueueCreate(const UTL_TypeInfo *dataType, bool byRef, int capacity);
+
+
+/** free the memory associated with the given queue. no other thread may use the queue anymore */
+extern void UTL_QueueDestroy(UTL_Queue *queue);
+
+
+
+#endif // UTL_QUEUE_H
@@ -0,0 +1,76 @@
+#ifndef UTL_SLOTMAP_H
+#define UTL_SLOTMAP_H
+
+
+
+#include "UTL/UTL.h"
+
+
+
+/** handle to an object of a slot map. the generation tells apart objects which used the same slot one after another,
+ *  so handles of removed objects stay invalid after their slot is reused. the zero handle is never valid */
+typedef struct {
+    uint32_t index;       // slot of the object
+    uint32_t generation;  // generation of the slot when the object was inserted
+} UTL_SlotHandle;
+
+
+
+/** pool of objects stored by value in a dense array, addressed by stable handles.
+ *  insert and remove are O(1), removing moves the last object into the hole */
+typedef struct {
+    const UTL_TypeInfo * const dataType;  // type of the contained data
+    const int                  count;     // number of objects currently in the slot map
+} UTL_SlotMap;
+
+
+
+// slot map functions /////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** copy an object into the slot map, returns its handle */
+extern UTL_SlotHandle UTL_SlotMapInsert(UTL_SlotMap *map, void *obj);
+
+
+/** the object with the given handle, NULL if it was removed. the pointer stays valid until objects are inserted or removed */
+extern void* UTL_SlotMapGet(UTL_SlotMap *map, UTL_SlotHandle handle);
+
+
+/** is the object with the given handle in the slot map? */
+extern bool UTL_SlotMapContains(UTL_SlotMap *map, UTL_SlotHandle handle);
+
+
+/** remove the object with the given handle, moving the last object of the dense array into its place.
+ *  returns false if the object was removed already */
+extern bool UTL_SlotMapRemove(UTL_SlotMap *map, UTL_SlotHandle handle);
+
+
+/** remove all objects, invalidating all handles */
+extern void UTL_SlotMapClear(UTL_SlotMap *map);
+
+
+/** make room for at least @capacity objects, so that inserting up to that many objects does not reallocate */
+extern void UTL_SlotMapReserve(UTL_SlotMap *map, int capacity);
+
+
+/** span over all objects in the dense array, in no particular order. valid until objects are inserted or removed */
+extern UTL_Span UTL_SlotMapGetSpan(UTL_SlotMap *map);
+
+
+/** handle of the object at index @at of the dense array, see UTL_SlotMapGetSpan(). the zero handle if out of bounds */
+extern UTL_SlotHandle UTL_SlotMapHandleAt(UTL_SlotMap *map, int at);
+
+
+// slot map constructors //////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new slot map for objects of type @dataType */
+extern UTL_SlotMap* UTL_SlotMapCreate(const UTL_TypeInfo *dataType);
+
+
+/** free the memory associated with the given slot map */
+extern void UTL_SlotMapDestroy(UTL_SlotMap *map);
+
+
+
+#endif // UTL_SLOTMAP_H
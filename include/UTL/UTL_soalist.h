@@ -0,0 +1,86 @@
+#ifndef UTL_SOALIST_H
+#define UTL_SOALIST_H
+
+
+
+#include "UTL/UTL.h"
+
+
+
+/** describes one field of the records stored in a UTL_SoAList */
+typedef struct {
+    size_t size;    /** size of the field in bytes */
+    size_t offset;  /** offset of the field within a record */
+} UTL_SoAField;
+
+
+// describe field @field of record type @type
+#define UTL_SoAFieldOf(type, field) ((UTL_SoAField) { .size = sizeof(((type*) 0)->field), .offset = offsetof(type, field) })
+
+
+
+/** list of records stored as structure of arrays: every field of the records is kept in a column of its own,
+ *  so that passes over a few fields only load these from memory */
+typedef struct {
+    const int    numFields;   // number of fields of each record
+    const size_t recordSize;  // size of a whole record in bytes
+    const int    count;       // number of records currently in the list
+} UTL_SoAList;
+
+
+
+// structure of arrays list functions /////////////////////////////////////////////////////////////////////////////////
+
+
+/** copy the record at index @at to @record. returns false if @at is out of bounds */
+extern bool UTL_SoAListGet(UTL_SoAList *list, int at, void *record);
+
+
+/** overwrite the record at index @at with @record */
+extern void UTL_SoAListSet(UTL_SoAList *list, int at, const void *record);
+
+
+/** pointer to field @field of the record at index @at, NULL if out of bounds */
+extern void* UTL_SoAListGetField(UTL_SoAList *list, int at, int field);
+
+
+/** append a new record to the back of the list */
+extern void UTL_SoAListPushBack(UTL_SoAList *list, const void *record);
+
+
+/** remove the last record from the list */
+extern void UTL_SoAListPopBack(UTL_SoAList *list);
+
+
+/** remove the record at index @at by moving the last record into its place. O(1), but does not keep the order */
+extern void UTL_SoAListSwapRemove(UTL_SoAList *list, int at);
+
+
+/** remove all records from the list, keeping its memory */
+extern void UTL_SoAListClear(UTL_SoAList *list);
+
+
+/** make room for at least @capacity records, so that pushing up to that many records does not reallocate */
+extern void UTL_SoAListReserve(UTL_SoAList *list, int capacity);
+
+
+/** the column of field @field: a span over that field of all records, stored contiguously and aligned to 64 bytes.
+ *  the span stays valid until records are pushed or the list is reserved */
+extern UTL_Span UTL_SoAListGetColumn(UTL_SoAList *list, int field);
+
+
+// structure of arrays list constructors //////////////////////////////////////////////////////////////////////////////
+
+
+/** Create a new structure of arrays list
+ *  @fields: the @numFields fields of a record, see UTL_SoAFieldOf()
+ *  @recordSize: size of a whole record, as passed to get, set and push */
+extern UTL_SoAList* UTL_SoAListCreate(const UTL_SoAField *fields, int numFields, size_t recordSize);
+
+
+/** free the memory associated with the given list */
+extern void UTL_SoAListDestroy(UTL_SoAList *list);
+
+
+
+#endif // UTL_SOALIST_H
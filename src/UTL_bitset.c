@@ -0,0 +1,301 @@
+#include "UTL/UTL.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+typedef struct {
+    int numBits;  // see UTL_BitSet
+
+    int       numWords;  // number of words holding the bits, bits beyond @numBits are always cleared
+    int       capacity;  // number of allocated words
+    uint64_t *words;     // the bits, bit i is bit (i % 64) of word (i / 64)
+} UTL_BitSetImpl;
+
+
+_STATIC_ASSERT(offsetof(UTL_BitSet, numBits) == offsetof(UTL_BitSetImpl, numBits));
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define UTL_BitSetNumWords(numBits) (((numBits) + 63) / 64)
+
+#define UTL_BitSetWord(set, bit) ((set)->words[(bit) / 64])
+
+#define UTL_BitSetMask(bit) ((uint64_t) 1 << ((bit) % 64))
+
+
+/* clear the unused bits of the last word */
+static void UTL_BitSetTrim(UTL_BitSetImpl *set) {
+    if (set->numBits % 64) set->words[set->numWords - 1] &= UTL_BitSetMask(set->numBits) - 1;
+}
+
+
+/* number of set bits in @n words */
+static int UTL_BitSetPopCount(const uint64_t *words, int n) {
+    uint64_t count = 0;
+    int i = 0;
+
+#if defined(__AVX2__)
+    // popcount of each nibble by table lookup, summed per 64 bit lane
+    const __m256i table  = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+        __m256i v  = _mm256_loadu_si256((const __m256i*) (words + i));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, acc);
+    count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+    // popcount of each byte by adding up bit pairs and nibbles, summed per 64 bit lane
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (words + i));
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi16(v, 1), m1));
+        v = _mm_add_epi8(_mm_and_si128(v, m2), _mm_and_si128(_mm_srli_epi16(v, 2), m2));
+        v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi16(v, 4)), m4);
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128()));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*) lanes, acc);
+    count = lanes[0] + lanes[1];
+#endif
+
+    for (; i < n; i++) count += (uint64_t) __builtin_popcountll(words[i]);
+    return (int) count;
+}
+
+
+// combine @n words of @src into @dst, a vector at a time
+#if defined(__AVX2__)
+#define UTL_BITSET_COMBINE_FUNC(name, vecOp, wordOp)                                                 \
+    static void name(uint64_t *dst, const uint64_t *src, int n) {                                    \
+        int i = 0;                                                                                   \
+        for (; i + 4 <= n; i += 4) {                                                                 \
+            __m256i d = _mm256_loadu_si256((const __m256i*) (dst + i));                              \
+            __m256i s = _mm256_loadu_si256((const __m256i*) (src + i));                              \
+            _mm256_storeu_si256((__m256i*) (dst + i), vecOp##256(d, s));                             \
+        }                                                                                            \
+        for (; i < n; i++) dst[i] = wordOp(dst[i], src[i]);                                          \
+    }
+#define UTL_BitSetVecAnd256(d, s)    _mm256_and_si256(d, s)
+#define UTL_BitSetVecOr256(d, s)     _mm256_or_si256(d, s)
+#define UTL_BitSetVecXor256(d, s)    _mm256_xor_si256(d, s)
+#define UTL_BitSetVecAndNot256(d, s) _mm256_andnot_si256(s, d)
+#elif defined(__SSE2__)
+#define UTL_BITSET_COMBINE_FUNC(name, vecOp, wordOp)                                                 \
+    static void name(uint64_t *dst, const uint64_t *src, int n) {                                    \
+        int i = 0;                                                                                   \
+        for (; i + 2 <= n; i += 2) {                                                                 \
+            __m128i d = _mm_loadu_si128((const __m128i*) (dst + i));                                 \
+            __m128i s = _mm_loadu_si128((const __m128i*) (src + i));                                 \
+            _mm_storeu_si128((__m128i*) (dst + i), vecOp##128(d, s));                                \
+        }                                                                                            \
+        for (; i < n; i++) dst[i] = wordOp(dst[i], src[i]);                                          \
+    }
+#define UTL_BitSetVecAnd128(d, s)    _mm_and_si128(d, s)
+#define UTL_BitSetVecOr128(d, s)     _mm_or_si128(d, s)
+#define UTL_BitSetVecXor128(d, s)    _mm_xor_si128(d, s)
+#define UTL_BitSetVecAndNot128(d, s) _mm_andnot_si128(s, d)
+#else
+#define UTL_BITSET_COMBINE_FUNC(name, vecOp, wordOp)                                                 \
+    static void name(uint64_t *dst, const uint64_t *src, int n) {                                    \
+        for (int i = 0; i < n; i++) dst[i] = wordOp(dst[i], src[i]);                                 \
+    }
+#endif
+
+#define UTL_BitSetWordAnd(d, s)    ((d) & (s))
+#define UTL_BitSetWordOr(d, s)     ((d) | (s))
+#define UTL_BitSetWordXor(d, s)    ((d) ^ (s))
+#define UTL_BitSetWordAndNot(d, s) ((d) & ~(s))
+
+UTL_BITSET_COMBINE_FUNC(UTL_BitSetCombineAnd,    UTL_BitSetVecAnd,    UTL_BitSetWordAnd)
+UTL_BITSET_COMBINE_FUNC(UTL_BitSetCombineOr,     UTL_BitSetVecOr,     UTL_BitSetWordOr)
+UTL_BITSET_COMBINE_FUNC(UTL_BitSetCombineXor,    UTL_BitSetVecXor,    UTL_BitSetWordXor)
+UTL_BITSET_COMBINE_FUNC(UTL_BitSetCombineAndNot, UTL_BitSetVecAndNot, UTL_BitSetWordAndNot)
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** set the bit at index @bit */
+void UTL_BitSetSet(UTL_BitSet *set, int bit) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (bit < 0 || bit >= impl->numBits) return;
+
+    UTL_BitSetWord(impl, bit) |= UTL_BitSetMask(bit);
+}
+
+
+/** clear the bit at index @bit */
+void UTL_BitSetClear(UTL_BitSet *set, int bit) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (bit < 0 || bit >= impl->numBits) return;
+
+    UTL_BitSetWord(impl, bit) &= ~UTL_BitSetMask(bit);
+}
+
+
+/** is the bit at index @bit set? */
+bool UTL_BitSetTest(UTL_BitSet *set, int bit) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (bit < 0 || bit >= impl->numBits) return false;
+
+    return (UTL_BitSetWord(impl, bit) & UTL_BitSetMask(bit)) != 0;
+}
+
+
+/** set all bits */
+void UTL_BitSetSetAll(UTL_BitSet *set) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (!impl->numWords) return;
+
+    memset(impl->words, 0xff, sizeof(uint64_t) * impl->numWords);
+    UTL_BitSetTrim(impl);
+}
+
+
+/** clear all bits */
+void UTL_BitSetClearAll(UTL_BitSet *set) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (impl->numWords) memset(impl->words, 0, sizeof(uint64_t) * impl->numWords);
+}
+
+
+/** change the number of bits of the set, added bits are cleared */
+void UTL_BitSetResize(UTL_BitSet *set, int numBits) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (numBits < 0) numBits = 0;
+
+    int numWords = UTL_BitSetNumWords(numBits);
+    if (numWords > impl->capacity) {
+        int capacity = impl->capacity ? impl->capacity : 1;
+        while (capacity < numWords) capacity *= 2;
+        impl->words    = realloc(impl->words, sizeof(uint64_t) * capacity);
+        impl->capacity = capacity;
+    }
+
+    // bits beyond the old size are cleared already within the last word
+    if (numWords > impl->numWords)
+        memset(impl->words + impl->numWords, 0, sizeof(uint64_t) * (numWords - impl->numWords));
+
+    impl->numBits  = numBits;
+    impl->numWords = numWords;
+    UTL_BitSetTrim(impl);
+}
+
+
+/** number of set bits */
+int UTL_BitSetCount(UTL_BitSet *set) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    return UTL_BitSetPopCount(impl->words, impl->numWords);
+}
+
+
+/** index of the first set bit, -1 if no bit is set */
+int UTL_BitSetFindFirst(UTL_BitSet *set) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+
+    for (int w = 0; w < impl->numWords; w++)
+        if (impl->words[w]) return w * 64 + __builtin_ctzll(impl->words[w]);
+
+    return -1;
+}
+
+
+/** index of the first set bit behind @bit, -1 if there is none */
+int UTL_BitSetFindNext(UTL_BitSet *set, int bit) {
+    UTL_BitSetImpl *impl = (UTL_BitSetImpl*) set;
+    if (bit < 0) return UTL_BitSetFindFirst(set);
+
+    bit++;
+    if (bit >= impl->numBits) return -1;
+
+    // rest of the word of @bit, then whole words
+    int w = bit / 64;
+    uint64_t word = impl->words[w] & ~(UTL_BitSetMask(bit) - 1);
+
+    while (!word) {
+        if (++w == impl->numWords) return -1;
+        word = impl->words[w];
+    }
+
+    return w * 64 + __builtin_ctzll(word);
+}
+
+
+/** @dst = @dst & @src */
+void UTL_BitSetAnd(UTL_BitSet *dst, UTL_BitSet *src) {
+    UTL_BitSetImpl *d = (UTL_BitSetImpl*) dst, *s = (UTL_BitSetImpl*) src;
+    int n = d->numWords < s->numWords ? d->numWords : s->numWords;
+
+    UTL_BitSetCombineAnd(d->words, s->words, n);
+    if (d->numWords > n) memset(d->words + n, 0, sizeof(uint64_t) * (d->numWords - n));
+}
+
+
+/** @dst = @dst | @src */
+void UTL_BitSetOr(UTL_BitSet *dst, UTL_BitSet *src) {
+    UTL_BitSetImpl *d = (UTL_BitSetImpl*) dst, *s = (UTL_BitSetImpl*) src;
+    int n = d->numWords < s->numWords ? d->numWords : s->numWords;
+
+    UTL_BitSetCombineOr(d->words, s->words, n);
+    UTL_BitSetTrim(d);
+}
+
+
+/** @dst = @dst ^ @src */
+void UTL_BitSetXor(UTL_BitSet *dst, UTL_BitSet *src) {
+    UTL_BitSetImpl *d = (UTL_BitSetImpl*) dst, *s = (UTL_BitSetImpl*) src;
+    int n = d->numWords < s->numWords ? d->numWords : s->numWords;
+
+    UTL_BitSetCombineXor(d->words, s->words, n);
+    UTL_BitSetTrim(d);
+}
+
+
+/** @dst = @dst & ~@src */
+void UTL_BitSetAndNot(UTL_BitSet *dst, UTL_BitSet *src) {
+    UTL_BitSetImpl *d = (UTL_BitSetImpl*) dst, *s = (UTL_BitSetImpl*) src;
+    int n = d->numWords < s->numWords ? d->numWords : s->numWords;
+
+    UTL_BitSetCombineAndNot(d->words, s->words, n);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new bitset of @numBits cleared bits */
+UTL_BitSet* UTL_BitSetCreate(int numBits) {
+    UTL_BitSetImpl *set = (UTL_BitSetImpl*) malloc(sizeof(UTL_BitSetImpl));
+
+    set->numBits  = 0;
+    set->numWords = 0;
+    set->capacity = 0;
+    set->words    = NULL;
+
+    UTL_BitSetResize((UTL_BitSet*) set, numBits);
+    return (UTL_BitSet*) set;
+}
+
+
+/** free the memory associated with the given bitset */
+void UTL_BitSetDestroy(UTL_BitSet *set) {
+    free(((UTL_BitSetImpl*) set)->words);
+    free(set);
+}
@@ -1,5 +1,19 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L  // clock_gettime()
+#endif
+
 #include "UTL/UTL.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 // functions and type information for int data type
 static int UTL_CompareInt(const void *p1, const void *p2) {
     const int *i1 = (const int*)p1;
@@ -77,3 +91,83 @@ const UTL_TypeInfo UTL_TypeInfoChar = (UTL_TypeInfo) {
     .copyFunc = &UTL_CopyChar,
     .name     = "char"
 };
+
+
+
+/** number of logical processors of this machine */
+int UTL_NumProcessors(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int) info.dwNumberOfProcessors;
+#else
+    long num = sysconf(_SC_NPROCESSORS_ONLN);
+    return num > 0 ? (int) num : 1;
+#endif
+}
+
+
+/** monotonic time in nanoseconds, for measuring durations */
+long long UTL_TimeNs(void) {
+#ifdef _WIN32
+    LARGE_INTEGER count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    // integer math keeps nanosecond precision however long the machine is up
+    long long ticks = count.QuadPart, perSecond = frequency.QuadPart;
+    return (ticks / perSecond) * 1000000000LL + (ticks % perSecond) * 1000000000LL / perSecond;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+#endif
+}
+
+
+/** map a whole file into memory read only and store its size in @size.
+ *  returns NULL if the file can't be opened or is empty */
+void* UTL_MapFile(const char *path, size_t *size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = NULL;
+    void *ptr = NULL;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping) {
+        ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+
+    if (ptr) *size = (size_t) fileSize.QuadPart;
+    return ptr;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat info;
+    void *ptr = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        ptr = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) ptr = NULL;
+    }
+    close(fd);
+
+    if (ptr) *size = (size_t) info.st_size;
+    return ptr;
+#endif
+}
+
+
+/** release a mapping returned by UTL_MapFile() */
+void UTL_UnmapFile(void *ptr, size_t size) {
+#ifdef _WIN32
+    (void) size;
+    UnmapViewOfFile(ptr);
+#else
+    munmap(ptr, size);
+#endif
+}
@@ -0,0 +1,568 @@
+#include "UTL/UTL.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+
+/* size of a cache line, the deques of workers are kept on separate lines */
+#define UTL_JOBS_CACHE_LINE 64
+
+/* initial number of jobs a worker's deque holds, it grows as needed */
+#define UTL_JOBS_DEQUE_INITIAL_CAPACITY 256
+
+/* number of jobs threads which are no workers can queue before they have to run jobs themselves */
+#define UTL_JOBS_INJECT_CAPACITY 1024
+
+/* number of finished jobs a worker keeps for reuse */
+#define UTL_JOBS_FREE_CACHE_SIZE 256
+
+/* number of dependents a job stores without allocating */
+#define UTL_JOBS_INLINE_DEPENDENTS 4
+
+/* number of times an idle worker looks for jobs before going to sleep */
+#define UTL_JOBS_SPIN_ROUNDS 64
+
+/* a parallel for without grain size aims at this many ranges per thread, to balance uneven work */
+#define UTL_JOBS_RANGES_PER_THREAD 16
+
+
+
+typedef struct UTL_JobsFor UTL_JobsFor;
+
+
+struct UTL_Job {
+    UTL_JobFunc *func;  // function of the job, NULL for jobs only waiting for their children
+    void        *aux;   // passed to @func
+    UTL_Job     *parent;
+
+    atomic_int unfinished;  // 1 until the job ran, plus the number of unfinished children
+    atomic_int waitingFor;  // number of unfinished dependencies, plus 1 while the job is set up
+    atomic_int refs;        // 1 for the handle, 1 until the job finished
+
+    atomic_flag lock;           // guards @done and the dependents
+    bool        done;           // finished, no more dependents are added
+    int         numDependents;
+    int         capDependents;
+    UTL_Job   **dependents;     // jobs waiting for this one, @inlineDependents or allocated
+    UTL_Job    *inlineDependents[UTL_JOBS_INLINE_DEPENDENTS];
+
+    UTL_JobsFor *forData;  // parallel for ranges: the parallel for
+    int          first;    // parallel for ranges: first index of the range
+    int          last;     // parallel for ranges: index behind the range
+
+    UTL_Job *nextFree;  // next job in a worker's cache of finished jobs
+};
+
+
+/* ring buffer of a worker's deque, replaced by a larger one when full */
+typedef struct UTL_JobsDequeBuffer {
+    long long                   mask;  // capacity - 1
+    struct UTL_JobsDequeBuffer *prev;  // the buffer replaced by this one, freed with the job system
+    _Atomic(UTL_Job*)           jobs[];
+} UTL_JobsDequeBuffer;
+
+
+/** a worker thread with its Chase-Lev deque: the owner pushes and takes jobs at the bottom, others steal at the top */
+typedef struct {
+    atomic_llong                 top;
+    uint8_t                      pad0[UTL_JOBS_CACHE_LINE - sizeof(atomic_llong)];
+    atomic_llong                 bottom;
+    _Atomic(UTL_JobsDequeBuffer*) buffer;
+
+    struct UTL_JobsImpl *jobs;
+    pthread_t            thread;
+    bool                 started;
+    unsigned             random;     // state for choosing workers to steal from
+    UTL_Job             *freeJobs;   // finished jobs for reuse
+    int                  numFreeJobs;
+    uint8_t              pad1[UTL_JOBS_CACHE_LINE];
+} UTL_JobsWorker;
+
+
+typedef struct UTL_JobsImpl {
+    int numWorkers;  // see UTL_Jobs
+
+    UTL_JobsWorker *workers;
+    UTL_Queue      *injected;   // jobs queued by threads which are no workers
+    pthread_key_t   workerKey;  // the UTL_JobsWorker of the current thread, NULL for other threads
+
+    atomic_int      numQueued;  // number of jobs in deques and @injected
+    atomic_int      sleeping;   // number of workers waiting for @wakeUp
+    atomic_bool     quit;
+    pthread_mutex_t mutex;
+    pthread_cond_t  wakeUp;
+} UTL_JobsImpl;
+
+
+_STATIC_ASSERT(offsetof(UTL_Jobs, numWorkers) == offsetof(UTL_JobsImpl, numWorkers));
+
+
+struct UTL_JobsFor {
+    UTL_JobsImpl     *jobs;       // job system running the ranges
+    UTL_JobRangeFunc *func;       // see UTL_JobsParallelFor()
+    void             *aux;        // see UTL_JobsParallelFor()
+    int               grainSize;  // ranges are not split below this size
+    UTL_Job          *root;       // job of the whole range, parent of all other ranges
+};
+
+
+
+// job deques /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static UTL_JobsDequeBuffer* UTL_JobsDequeBufferCreate(long long capacity, UTL_JobsDequeBuffer *prev) {
+    UTL_JobsDequeBuffer *buffer = malloc(sizeof(UTL_JobsDequeBuffer) + sizeof(_Atomic(UTL_Job*)) * capacity);
+    buffer->mask = capacity - 1;
+    buffer->prev = prev;
+    return buffer;
+}
+
+
+/* push a job to the bottom of the deque, only called by its worker */
+static void UTL_JobsDequePush(UTL_JobsWorker *worker, UTL_Job *job) {
+    long long bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed);
+    long long top    = atomic_load_explicit(&worker->top,    memory_order_acquire);
+    UTL_JobsDequeBuffer *buffer = atomic_load_explicit(&worker->buffer, memory_order_relaxed);
+
+    // full -> move the jobs to a buffer twice the size, thieves may still read the old one
+    if (bottom - top > buffer->mask) {
+        UTL_JobsDequeBuffer *grown = UTL_JobsDequeBufferCreate(2 * (buffer->mask + 1), buffer);
+        for (long long i = top; i < bottom; i++)
+            atomic_store_explicit(&grown->jobs[i & grown->mask],
+                                  atomic_load_explicit(&buffer->jobs[i & buffer->mask], memory_order_relaxed),
+                                  memory_order_relaxed);
+        atomic_store_explicit(&worker->buffer, grown, memory_order_release);
+        buffer = grown;
+    }
+
+    atomic_store_explicit(&buffer->jobs[bottom & buffer->mask], job, memory_order_relaxed);
+    atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_release);
+}
+
+
+/* take the job at the bottom of the deque, only called by its worker. returns NULL if the deque is empty */
+static UTL_Job* UTL_JobsDequeTake(UTL_JobsWorker *worker) {
+    long long bottom = atomic_load_explicit(&worker->bottom, memory_order_relaxed) - 1;
+    UTL_JobsDequeBuffer *buffer = atomic_load_explicit(&worker->buffer, memory_order_relaxed);
+    atomic_store_explicit(&worker->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&worker->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    UTL_Job *job = atomic_load_explicit(&buffer->jobs[bottom & buffer->mask], memory_order_relaxed);
+
+    // last job -> race thieves for it
+    if (top == bottom) {
+        if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+            job = NULL;
+        atomic_store_explicit(&worker->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    return job;
+}
+
+
+/* steal the job at the top of the deque, called by any thread. returns NULL if the deque is empty, or another
+ * thread got the job first */
+static UTL_Job* UTL_JobsDequeSteal(UTL_JobsWorker *worker) {
+    long long top = atomic_load_explicit(&worker->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&worker->bottom, memory_order_acquire);
+
+    if (top >= bottom) return NULL;
+
+    UTL_JobsDequeBuffer *buffer = atomic_load_explicit(&worker->buffer, memory_order_acquire);
+    UTL_Job *job = atomic_load_explicit(&buffer->jobs[top & buffer->mask], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&worker->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+
+    return job;
+}
+
+
+// scheduling /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static void UTL_JobsExecute(UTL_JobsImpl *jobs, UTL_Job *job);
+
+
+#define UTL_JobsCurrentWorker(jobs) ((UTL_JobsWorker*) pthread_getspecific((jobs)->workerKey))
+
+
+/* find a queued job: first in the own deque, then among the injected jobs, then in the deques of other workers.
+ * @worker is NULL for threads which are no workers. returns NULL if no job was found */
+static UTL_Job* UTL_JobsFind(UTL_JobsImpl *jobs, UTL_JobsWorker *worker) {
+    UTL_Job *job = NULL;
+
+    if (worker) job = UTL_JobsDequeTake(worker);
+    if (!job) UTL_QueueTryPop(jobs->injected, &job);
+
+    if (!job) {
+        unsigned start = 0;
+        if (worker) {
+            worker->random ^= worker->random << 13;
+            worker->random ^= worker->random >> 17;
+            worker->random ^= worker->random << 5;
+            start = worker->random;
+        }
+
+        for (int i = 0; i < jobs->numWorkers && !job; i++) {
+            UTL_JobsWorker *victim = &jobs->workers[(start + i) % jobs->numWorkers];
+            if (victim != worker) job = UTL_JobsDequeSteal(victim);
+        }
+    }
+
+    if (job) atomic_fetch_sub(&jobs->numQueued, 1);
+    return job;
+}
+
+
+/* queue a job whose dependencies have finished, to the deque of the current worker, or to the injected jobs */
+static void UTL_JobsPush(UTL_JobsImpl *jobs, UTL_Job *job) {
+    UTL_JobsWorker *worker = UTL_JobsCurrentWorker(jobs);
+
+    atomic_fetch_add(&jobs->numQueued, 1);
+
+    if (worker) {
+        UTL_JobsDequePush(worker, job);
+    }
+    else {
+        // the injected jobs are full -> help running jobs until there is room
+        while (!UTL_QueueTryPush(jobs->injected, job)) {
+            UTL_Job *other = UTL_JobsFind(jobs, NULL);
+            if (other) UTL_JobsExecute(jobs, other);
+            else       sched_yield();
+        }
+    }
+
+    if (atomic_load(&jobs->sleeping) > 0) {
+        pthread_mutex_lock(&jobs->mutex);
+        pthread_cond_signal(&jobs->wakeUp);
+        pthread_mutex_unlock(&jobs->mutex);
+    }
+}
+
+
+/* is the current thread's deque empty, so that idle workers would have nothing to steal from it? */
+static bool UTL_JobsLocalEmpty(UTL_JobsImpl *jobs) {
+    UTL_JobsWorker *worker = UTL_JobsCurrentWorker(jobs);
+    if (!worker) return UTL_QueueCount(jobs->injected) == 0;
+
+    return atomic_load_explicit(&worker->bottom, memory_order_relaxed) <= atomic_load_explicit(&worker->top, memory_order_relaxed);
+}
+
+
+// jobs ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static UTL_Job* UTL_JobsAlloc(UTL_JobsImpl *jobs, UTL_JobFunc *func, void *aux, UTL_Job *parent, int refs) {
+    UTL_JobsWorker *worker = UTL_JobsCurrentWorker(jobs);
+    UTL_Job *job;
+
+    if (worker && worker->freeJobs) {
+        job = worker->freeJobs;
+        worker->freeJobs = job->nextFree;
+        worker->numFreeJobs--;
+    }
+    else {
+        job = malloc(sizeof(UTL_Job));
+    }
+
+    job->func   = func;
+    job->aux    = aux;
+    job->parent = parent;
+    atomic_init(&job->unfinished, 1);
+    atomic_init(&job->waitingFor, 1);
+    atomic_init(&job->refs, refs);
+    atomic_flag_clear(&job->lock);
+    job->done          = false;
+    job->numDependents = 0;
+    job->capDependents = UTL_JOBS_INLINE_DEPENDENTS;
+    job->dependents    = job->inlineDependents;
+
+    if (parent) atomic_fetch_add(&parent->unfinished, 1);
+    return job;
+}
+
+
+/* drop one reference to a job, the last one frees it */
+static void UTL_JobsRelease(UTL_JobsImpl *jobs, UTL_Job *job) {
+    if (atomic_fetch_sub_explicit(&job->refs, 1, memory_order_acq_rel) != 1) return;
+
+    UTL_JobsWorker *worker = jobs ? UTL_JobsCurrentWorker(jobs) : NULL;
+    if (worker && worker->numFreeJobs < UTL_JOBS_FREE_CACHE_SIZE) {
+        job->nextFree = worker->freeJobs;
+        worker->freeJobs = job;
+        worker->numFreeJobs++;
+    }
+    else {
+        free(job);
+    }
+}
+
+
+/* let @job wait for @dep, unless it has finished already */
+static void UTL_JobsAddDependency(UTL_Job *job, UTL_Job *dep) {
+    while (atomic_flag_test_and_set_explicit(&dep->lock, memory_order_acquire))
+        ;
+
+    if (!dep->done) {
+        if (dep->numDependents == dep->capDependents) {
+            UTL_Job **dependents = malloc(sizeof(UTL_Job*) * dep->capDependents * 2);
+            memcpy(dependents, dep->dependents, sizeof(UTL_Job*) * dep->numDependents);
+            if (dep->dependents != dep->inlineDependents) free(dep->dependents);
+            dep->dependents = dependents;
+            dep->capDependents *= 2;
+        }
+
+        dep->dependents[dep->numDependents++] = job;
+        atomic_fetch_add(&job->waitingFor, 1);
+    }
+
+    atomic_flag_clear_explicit(&dep->lock, memory_order_release);
+}
+
+
+/* the job is set up, or one of its dependencies finished -> queue it once it has nothing left to wait for */
+static void UTL_JobsDependencyDone(UTL_JobsImpl *jobs, UTL_Job *job) {
+    if (atomic_fetch_sub(&job->waitingFor, 1) == 1)
+        UTL_JobsPush(jobs, job);
+}
+
+
+/* the job ran, or one of its children finished -> finish the job once both happened */
+static void UTL_JobsFinish(UTL_JobsImpl *jobs, UTL_Job *job) {
+    if (atomic_fetch_sub(&job->unfinished, 1) != 1) return;
+
+    while (atomic_flag_test_and_set_explicit(&job->lock, memory_order_acquire))
+        ;
+    job->done = true;
+    atomic_flag_clear_explicit(&job->lock, memory_order_release);
+
+    for (int i = 0; i < job->numDependents; i++)
+        UTL_JobsDependencyDone(jobs, job->dependents[i]);
+    if (job->dependents != job->inlineDependents) free(job->dependents);
+
+    if (job->parent) UTL_JobsFinish(jobs, job->parent);
+    UTL_JobsRelease(jobs, job);
+}
+
+
+static void UTL_JobsExecute(UTL_JobsImpl *jobs, UTL_Job *job) {
+    if (job->func) job->func(job->aux);
+    UTL_JobsFinish(jobs, job);
+}
+
+
+/* wait for @job to finish, running queued jobs in the meantime */
+static void UTL_JobsHelpUntilDone(UTL_JobsImpl *jobs, UTL_Job *job) {
+    UTL_JobsWorker *worker = UTL_JobsCurrentWorker(jobs);
+
+    while (!UTL_JobIsDone(job)) {
+        UTL_Job *other = UTL_JobsFind(jobs, worker);
+        if (other) UTL_JobsExecute(jobs, other);
+        else       sched_yield();
+    }
+}
+
+
+// parallel for ///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* job of a range of a parallel for: splits off the upper half of the range as long as idle workers could steal it
+ * (lazy binary splitting), otherwise works through the range grain by grain */
+static void UTL_JobsForRun(void *aux) {
+    UTL_Job      *range = (UTL_Job*) aux;
+    UTL_JobsFor  *pf    = range->forData;
+    UTL_JobsImpl *jobs  = pf->jobs;
+    int first = range->first, last = range->last;
+
+    while (last - first > pf->grainSize) {
+        if (UTL_JobsLocalEmpty(jobs)) {
+            int mid = first + (last - first) / 2;
+
+            UTL_Job *half = UTL_JobsAlloc(jobs, &UTL_JobsForRun, NULL, pf->root, 1);
+            half->aux     = half;
+            half->forData = pf;
+            half->first   = mid;
+            half->last    = last;
+            UTL_JobsDependencyDone(jobs, half);
+
+            last = mid;
+        }
+        else {
+            pf->func(pf->aux, first, first + pf->grainSize);
+            first += pf->grainSize;
+        }
+    }
+
+    pf->func(pf->aux, first, last);
+}
+
+
+// public job functions ///////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** run func(@aux) as a job on the workers, once the @numDeps jobs at @deps have finished */
+UTL_Job* UTL_JobsRun(UTL_Jobs *jobs, UTL_JobFunc *func, void *aux, UTL_Job *parent, UTL_Job * const *deps, int numDeps) {
+    UTL_JobsImpl *impl = (UTL_JobsImpl*) jobs;
+    UTL_Job *job = UTL_JobsAlloc(impl, func, aux, parent, 2);
+
+    for (int i = 0; i < numDeps; i++)
+        if (deps[i]) UTL_JobsAddDependency(job, deps[i]);
+
+    UTL_JobsDependencyDone(impl, job);
+    return job;
+}
+
+
+/** wait for a job and all of its children to finish and release its handle */
+void UTL_JobsWait(UTL_Jobs *jobs, UTL_Job *job) {
+    UTL_JobsHelpUntilDone((UTL_JobsImpl*) jobs, job);
+    UTL_JobsRelease((UTL_JobsImpl*) jobs, job);
+}
+
+
+/** call func(@aux, first, last) for consecutive ranges covering [0, @count) on the workers and wait for all of them */
+void UTL_JobsParallelFor(UTL_Jobs *jobs, int count, UTL_JobRangeFunc *func, void *aux, int grainSize) {
+    UTL_JobsImpl *impl = (UTL_JobsImpl*) jobs;
+    if (count <= 0) return;
+
+    if (grainSize <= 0) grainSize = count / ((impl->numWorkers + 1) * UTL_JOBS_RANGES_PER_THREAD);
+    if (grainSize <= 0) grainSize = 1;
+
+    // the root has no function of its own, it only waits for the ranges
+    UTL_JobsFor pf = { .jobs = impl, .func = func, .aux = aux, .grainSize = grainSize };
+    pf.root = UTL_JobsAlloc(impl, NULL, NULL, NULL, 2);
+
+    UTL_Job *range = UTL_JobsAlloc(impl, &UTL_JobsForRun, NULL, pf.root, 1);
+    range->aux     = range;
+    range->forData = &pf;
+    range->first   = 0;
+    range->last    = count;
+    UTL_JobsDependencyDone(impl, range);
+
+    UTL_JobsFinish(impl, pf.root);
+    UTL_JobsHelpUntilDone(impl, pf.root);
+    UTL_JobsRelease(impl, pf.root);
+}
+
+
+/** has the job and all of its children finished? */
+bool UTL_JobIsDone(UTL_Job *job) {
+    return atomic_load_explicit(&job->unfinished, memory_order_acquire) == 0;
+}
+
+
+/** release the handle of a job without waiting for it */
+void UTL_JobRelease(UTL_Job *job) {
+    UTL_JobsRelease(NULL, job);
+}
+
+
+// job system constructors ////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static void* UTL_JobsWorkerMain(void *arg) {
+    UTL_JobsWorker *worker = (UTL_JobsWorker*) arg;
+    UTL_JobsImpl   *jobs   = worker->jobs;
+    int idle = 0;
+
+    pthread_setspecific(jobs->workerKey, worker);
+
+    while (!atomic_load(&jobs->quit)) {
+        UTL_Job *job = UTL_JobsFind(jobs, worker);
+        if (job) {
+            UTL_JobsExecute(jobs, job);
+            idle = 0;
+        }
+        else if (++idle < UTL_JOBS_SPIN_ROUNDS) {
+            sched_yield();
+        }
+        else {
+            // registered as sleeping before checking for jobs, so that pushes either see the sleeper or get seen
+            pthread_mutex_lock(&jobs->mutex);
+            atomic_fetch_add(&jobs->sleeping, 1);
+            while (atomic_load(&jobs->numQueued) <= 0 && !atomic_load(&jobs->quit))
+                pthread_cond_wait(&jobs->wakeUp, &jobs->mutex);
+            atomic_fetch_sub(&jobs->sleeping, 1);
+            pthread_mutex_unlock(&jobs->mutex);
+            idle = 0;
+        }
+    }
+
+    return NULL;
+}
+
+
+/** create a new job system with @numWorkers worker threads, one per processor if not positive */
+UTL_Jobs* UTL_JobsCreate(int numWorkers) {
+    UTL_JobsImpl *jobs = (UTL_JobsImpl*) malloc(sizeof(UTL_JobsImpl));
+
+    jobs->numWorkers = numWorkers > 0 ? numWorkers : UTL_NumProcessors();
+    jobs->workers    = calloc(jobs->numWorkers, sizeof(UTL_JobsWorker));
+    jobs->injected   = UTL_QueueCreate(&UTL_TypeInfoInt, true, UTL_JOBS_INJECT_CAPACITY);
+
+    pthread_key_create(&jobs->workerKey, NULL);
+    pthread_mutex_init(&jobs->mutex, NULL);
+    pthread_cond_init(&jobs->wakeUp, NULL);
+    atomic_init(&jobs->numQueued, 0);
+    atomic_init(&jobs->sleeping, 0);
+    atomic_init(&jobs->quit, false);
+
+    for (int i = 0; i < jobs->numWorkers; i++) {
+        UTL_JobsWorker *worker = &jobs->workers[i];
+        atomic_init(&worker->top, 0);
+        atomic_init(&worker->bottom, 0);
+        atomic_init(&worker->buffer, UTL_JobsDequeBufferCreate(UTL_JOBS_DEQUE_INITIAL_CAPACITY, NULL));
+        worker->jobs   = jobs;
+        worker->random = 2463534242u + 7919u * (unsigned) i;
+    }
+
+    for (int i = 0; i < jobs->numWorkers; i++)
+        jobs->workers[i].started = pthread_create(&jobs->workers[i].thread, NULL, &UTL_JobsWorkerMain, &jobs->workers[i]) == 0;
+
+    return (UTL_Jobs*) jobs;
+}
+
+
+/** stop the workers and free the memory associated with the given job system */
+void UTL_JobsDestroy(UTL_Jobs *jobs) {
+    UTL_JobsImpl *impl = (UTL_JobsImpl*) jobs;
+
+    pthread_mutex_lock(&impl->mutex);
+    atomic_store(&impl->quit, true);
+    pthread_cond_broadcast(&impl->wakeUp);
+    pthread_mutex_unlock(&impl->mutex);
+
+    for (int i = 0; i < impl->numWorkers; i++) {
+        UTL_JobsWorker *worker = &impl->workers[i];
+        if (worker->started) pthread_join(worker->thread, NULL);
+
+        UTL_JobsDequeBuffer *buffer = atomic_load(&worker->buffer);
+        while (buffer) {
+            UTL_JobsDequeBuffer *prev = buffer->prev;
+            free(buffer);
+            buffer = prev;
+        }
+
+        while (worker->freeJobs) {
+            UTL_Job *next = worker->freeJobs->nextFree;
+            free(worker->freeJobs);
+            worker->freeJobs = next;
+        }
+    }
+
+    UTL_QueueDestroy(impl->injected);
+    pthread_key_delete(impl->workerKey);
+    pthread_mutex_destroy(&impl->mutex);
+    pthread_cond_destroy(&impl->wakeUp);
+    free(impl->workers);
+    free(impl);
+}
@@ -1,7 +1,42 @@
 #include "UTL/UTL.h"
 
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
-#define UTL_ARRAY_LIST_INITIAL_CAPACITY 64
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+/* capacity allocated by an array list on its first push, lists are created without a buffer */
+#define UTL_ARRAY_LIST_INITIAL_CAPACITY 8
+
+/* number of nodes in the first slab of a node pool, following slabs double in size */
+#define UTL_NODE_POOL_INITIAL_SLAB_SIZE 8
+
+/* maximum number of nodes in one slab of a node pool */
+#define UTL_NODE_POOL_MAX_SLAB_SIZE 1024
+
+/* capacity allocated by a deque list on its first push, has to be a power of two */
+#define UTL_DEQUE_LIST_INITIAL_CAPACITY 8
+
+/* targeted size in bytes of the objects in one chunk of an unrolled list */
+#define UTL_UNROLLED_LIST_CHUNK_BYTES 1024
+
+/* minimum number of objects in one chunk of an unrolled list */
+#define UTL_UNROLLED_LIST_MIN_CHUNK_CAPACITY 8
+
+/* maximum number of children of an inner node of a tree list */
+#define UTL_TREE_LIST_FANOUT 32
+
+/* targeted size in bytes of the objects in one leaf of a tree list */
+#define UTL_TREE_LIST_LEAF_BYTES 1024
+
+/* minimum number of objects in one leaf of a tree list */
+#define UTL_TREE_LIST_MIN_LEAF_CAPACITY 8
 
 
 
@@ -12,8 +47,12 @@ typedef struct {
     bool                byRef;    // see UTL_List
     int                 count;    // see UTL_List
 
-    int      capacity; // maximum number of objects that could be stored in this list without relocation
-    uint8_t *data;     // array containing all objects
+    int      capacity;       // maximum number of objects that could be stored in this list without relocation
+    int      inlineCapacity; // number of objects fitting into @inlineData, 0 if the list has no inline buffer
+    uint8_t *data;           // array containing all objects, either @inlineData, in @mapping or allocated on the heap
+    void    *mapping;        // file mapping @data points into, NULL if the list was not mapped from a file
+    size_t   mappingSize;    // size of @mapping in bytes
+    uint8_t  inlineData[];   // small buffer allocated together with the list, used until it overflows
 } UTL_ArrayList;
 
 
@@ -25,6 +64,27 @@ struct UTL_LinkedListNode {
     uint8_t obj[];
 };
 
+
+/** one block of nodes allocated by a node pool */
+typedef struct UTL_ListNodeSlab UTL_ListNodeSlab;
+struct UTL_ListNodeSlab {
+    UTL_ListNodeSlab *next;     // next slab of the same pool
+    size_t            numNodes; // number of nodes in this slab
+    uint8_t           nodes[];  // the nodes
+};
+
+/** slab allocator for the nodes of linked lists */
+struct UTL_ListNodePool {
+    size_t              nodeSize;     // size of one node including its object, padded for alignment
+    int                 refCount;     // number of lists and handles using this pool
+    int                 nextSlabSize; // number of nodes in the next slab to allocate
+    UTL_ListNodeSlab   *slabs;        // all slabs of this pool
+    UTL_LinkedListNode *freeNodes;    // returned nodes, linked through their next pointer
+    uint8_t            *unused;       // nodes in the newest slab that were never handed out start here ..
+    uint8_t            *unusedEnd;    // .. and end here
+};
+
+
 /** list of objects, backed by linked nodes */
 typedef struct {
     UTL_ListType        listType; // see UTL_List
@@ -32,23 +92,116 @@ typedef struct {
     bool                byRef;    // see UTL_List
     int                 count;    // see UTL_List
 
+    UTL_ListNodePool  *pool;     // allocator for the nodes, either &ownPool or shared with other lists
+    UTL_ListNodePool   ownPool;  // the list's private allocator, unused if a shared pool is given
     UTL_LinkedListNode sentinel; // first and last node of the list
 } UTL_LinkedList;
 
 
 
 
-_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_ArrayList,  listType));
-_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_LinkedList, listType));
+/** list of objects, backed by a circular buffer */
+typedef struct {
+    UTL_ListType        listType; // see UTL_List
+    const UTL_TypeInfo *dataType; // see UTL_List
+    bool                byRef;    // see UTL_List
+    int                 count;    // see UTL_List
+
+    int      capacity; // size of the buffer, 0 or a power of two
+    int      head;     // position of the first object in the buffer
+    uint8_t *data;     // buffer containing all objects, wrapping around at its end
+} UTL_DequeList;
+
+
+
+/** a chunk of objects in an unrolled list */
+typedef struct UTL_UnrolledListChunk UTL_UnrolledListChunk;
+struct UTL_UnrolledListChunk {
+    UTL_UnrolledListChunk *next;     // next chunk, or NULL
+    UTL_UnrolledListChunk *prev;     // previous chunk, or NULL
+    int                    count;    // number of objects currently in this chunk
+    int                    reserved; // keeps @data 8 byte aligned
+    uint8_t                data[];   // the objects
+};
+
+/** list of objects, backed by linked chunks of up to @chunkCapacity objects */
+typedef struct {
+    UTL_ListType        listType; // see UTL_List
+    const UTL_TypeInfo *dataType; // see UTL_List
+    bool                byRef;    // see UTL_List
+    int                 count;    // see UTL_List
+
+    int                    chunkCapacity; // maximum number of objects in one chunk
+    UTL_UnrolledListChunk *head;          // first chunk, or NULL if empty
+    UTL_UnrolledListChunk *tail;          // last chunk, or NULL if empty
+} UTL_UnrolledList;
+
+
+
+/** common head of the leaves and inner nodes of a tree list */
+typedef struct UTL_TreeListInner UTL_TreeListInner;
+typedef struct {
+    UTL_TreeListInner *parent; // parent node, or NULL for the root
+    int                size;   // number of children of an inner node, or of objects in a leaf
+    bool               isLeaf; // whether this node is a UTL_TreeListLeaf or a UTL_TreeListInner
+} UTL_TreeListNode;
+
+/** an inner node of a tree list, keeping the number of objects below each child */
+struct UTL_TreeListInner {
+    UTL_TreeListNode  node;                            // see UTL_TreeListNode
+    int               counts[UTL_TREE_LIST_FANOUT];    // number of objects below each child
+    UTL_TreeListNode *children[UTL_TREE_LIST_FANOUT];  // the children, all on the same level
+};
+
+/** a leaf of a tree list holding the objects. leaves are linked in list order */
+typedef struct UTL_TreeListLeaf UTL_TreeListLeaf;
+struct UTL_TreeListLeaf {
+    UTL_TreeListNode  node;   // see UTL_TreeListNode
+    UTL_TreeListLeaf *next;   // next leaf, or NULL
+    UTL_TreeListLeaf *prev;   // previous leaf, or NULL
+    uint8_t           data[]; // the objects
+};
+
+/** list of objects, backed by a B+tree counting the objects below each node */
+typedef struct {
+    UTL_ListType        listType; // see UTL_List
+    const UTL_TypeInfo *dataType; // see UTL_List
+    bool                byRef;    // see UTL_List
+    int                 count;    // see UTL_List
+
+    int               leafCapacity; // maximum number of objects in one leaf
+    int               height;       // number of inner node levels above the leaves
+    UTL_TreeListNode *root;         // root node, a single (maybe empty) leaf for small lists
+    UTL_TreeListLeaf *head;         // first leaf
+    UTL_TreeListLeaf *tail;         // last leaf
+} UTL_TreeList;
+
+
+
 
-_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_ArrayList,  dataType));
-_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_LinkedList, dataType));
+_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_ArrayList,    listType));
+_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_LinkedList,   listType));
+_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_UnrolledList, listType));
+_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_DequeList,    listType));
+_STATIC_ASSERT(offsetof(UTL_List, listType) == offsetof(UTL_TreeList,     listType));
 
-_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_ArrayList,  byRef));
-_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_LinkedList, byRef));
+_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_ArrayList,    dataType));
+_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_LinkedList,   dataType));
+_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_UnrolledList, dataType));
+_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_DequeList,    dataType));
+_STATIC_ASSERT(offsetof(UTL_List, dataType) == offsetof(UTL_TreeList,     dataType));
 
-_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_ArrayList,  count));
-_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_LinkedList, count));
+_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_ArrayList,    byRef));
+_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_LinkedList,   byRef));
+_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_UnrolledList, byRef));
+_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_DequeList,    byRef));
+_STATIC_ASSERT(offsetof(UTL_List, byRef) == offsetof(UTL_TreeList,     byRef));
+
+_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_ArrayList,    count));
+_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_LinkedList,   count));
+_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_UnrolledList, count));
+_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_DequeList,    count));
+_STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_TreeList,     count));
 
 
 
@@ -61,306 +214,4283 @@ _STATIC_ASSERT(offsetof(UTL_List, count) == offsetof(UTL_LinkedList, count));
 
 #define UTL_ListPos2Obj(list, obj) (list->byRef ? *((void**)(obj)) : (void*)(obj))
 
+#define UTL_UnrolledListAt(list, chunk, offset) ((chunk)->data + UTL_ListDataSize(list) * (offset))
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define UTL_TreeListAt(list, leaf, offset) ((leaf)->data + UTL_ListDataSize(list) * (offset))
 
+#define UTL_DequeListAt(list, at) ((list)->data + UTL_ListDataSize(list) * (((list)->head + (at)) & ((list)->capacity - 1)))
 
-static void UTL_ArrayListDestroy(UTL_ArrayList *list) {
-    free(list->data);
-    free(list);
+
+// node pools /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static void UTL_ListNodePoolInit(UTL_ListNodePool *pool, size_t dataSize) {
+    pool->nodeSize     = UTL_GenericAddPadding(sizeof(UTL_LinkedListNode) + dataSize);
+    pool->refCount     = 1;
+    pool->nextSlabSize = UTL_NODE_POOL_INITIAL_SLAB_SIZE;
+    pool->slabs        = NULL;
+    pool->freeNodes    = NULL;
+    pool->unused       = NULL;
+    pool->unusedEnd    = NULL;
 }
 
 
-static void UTL_LinkedListDestroy(UTL_LinkedList *list) {
-    UTL_LinkedListNode *node = list->sentinel.next;
-    while (node != &list->sentinel) {
-        UTL_LinkedListNode *next = node->next;
-        free(node);
-        node = next;
+/* free all slabs of a pool, and with them every node ever allocated from it */
+static void UTL_ListNodePoolFreeSlabs(UTL_ListNodePool *pool) {
+    UTL_ListNodeSlab *slab = pool->slabs;
+    while (slab) {
+        UTL_ListNodeSlab *next = slab->next;
+        free(slab);
+        slab = next;
     }
-    free(list);
+    pool->slabs     = NULL;
+    pool->freeNodes = NULL;
+    pool->unused    = NULL;
+    pool->unusedEnd = NULL;
 }
 
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
+static void UTL_ListNodePoolFree(UTL_ListNodePool *pool, UTL_LinkedListNode *node) {
+    node->next = pool->freeNodes;
+    pool->freeNodes = node;
+}
 
-void* UTL_ArrayListGet(UTL_ArrayList *list, int at) {
 
-    if (at >= list->count) return NULL;
+/* start handing out nodes from a new slab of @numNodes nodes.
+ * the nodes of the previous slab that were never handed out go to the free list */
+static void UTL_ListNodePoolAddSlab(UTL_ListNodePool *pool, size_t numNodes) {
+    for (; pool->unused < pool->unusedEnd; pool->unused += pool->nodeSize)
+        UTL_ListNodePoolFree(pool, (UTL_LinkedListNode*) pool->unused);
 
-    uint8_t *pos = list->data + UTL_ListDataSize(list) * at;
-    return UTL_ListPos2Obj(list, pos);
+    UTL_ListNodeSlab *slab = malloc(sizeof(UTL_ListNodeSlab) + pool->nodeSize * numNodes);
+    slab->numNodes  = numNodes;
+    slab->next      = pool->slabs;
+    pool->slabs     = slab;
+    pool->unused    = slab->nodes;
+    pool->unusedEnd = slab->nodes + pool->nodeSize * numNodes;
 }
 
 
-void* UTL_LinkedListGet(UTL_LinkedList *list, int at) {
-
-    if (at >= list->count) return NULL;
+static UTL_LinkedListNode* UTL_ListNodePoolAlloc(UTL_ListNodePool *pool) {
+    UTL_LinkedListNode *node = pool->freeNodes;
+    if (node) {
+        pool->freeNodes = node->next;
+        return node;
+    }
 
-    UTL_LinkedListNode *node = list->sentinel.next;
-    while (at--) node = node->next;
+    if (pool->unused == pool->unusedEnd) {
+        UTL_ListNodePoolAddSlab(pool, pool->nextSlabSize);
+        if (pool->nextSlabSize < UTL_NODE_POOL_MAX_SLAB_SIZE) pool->nextSlabSize *= 2;
+    }
 
-    return UTL_ListPos2Obj(list, node->obj);
+    // hand out nodes of the newest slab in address order
+    node = (UTL_LinkedListNode*) pool->unused;
+    pool->unused += pool->nodeSize;
+    return node;
 }
 
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/* allocate @n nodes lying one after another in memory, from the newest slab if it has enough unused nodes left */
+static uint8_t* UTL_ListNodePoolAllocRun(UTL_ListNodePool *pool, int n) {
+    if (pool->unusedEnd - pool->unused < (ptrdiff_t) (pool->nodeSize * n))
+        UTL_ListNodePoolAddSlab(pool, n > pool->nextSlabSize ? n : pool->nextSlabSize);
 
+    uint8_t *run = pool->unused;
+    pool->unused += pool->nodeSize * n;
+    return run;
+}
 
-void* UTL_ArrayListGetBack(UTL_ArrayList *list) {
-    if (list->count == 0) return NULL;
 
-    uint8_t *pos = list->data + UTL_ListDataSize(list) * list->count - 1;
-    return UTL_ListPos2Obj(list, pos);
+/* drop one reference to a shared pool */
+static void UTL_ListNodePoolRelease(UTL_ListNodePool *pool) {
+    if (--pool->refCount > 0) return;
+    UTL_ListNodePoolFreeSlabs(pool);
+    free(pool);
 }
 
 
-void* UTL_LinkedListGetBack(UTL_LinkedList *list) {
-    if (list->count == 0) return NULL;
+// unrolled list chunks ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    return UTL_ListPos2Obj(list, list->sentinel.prev->obj);
-}
 
+/* allocate an empty chunk and link it in behind @prev, or at the front if @prev is NULL */
+static UTL_UnrolledListChunk* UTL_UnrolledListLinkChunk(UTL_UnrolledList *list, UTL_UnrolledListChunk *prev) {
+    UTL_UnrolledListChunk *chunk = malloc(sizeof(UTL_UnrolledListChunk) + UTL_ListDataSize(list) * list->chunkCapacity);
+    chunk->count = 0;
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    chunk->prev = prev;
+    chunk->next = prev ? prev->next : list->head;
 
+    if (chunk->next) chunk->next->prev = chunk;
+    else             list->tail = chunk;
 
-void* UTL_ArrayListGetFront(UTL_ArrayList *list) {
-    if (list->count == 0) return NULL;
+    if (prev) prev->next = chunk;
+    else      list->head = chunk;
 
-    return UTL_ListPos2Obj(list, list->data);
+    return chunk;
 }
 
 
-void* UTL_LinkedListGetFront(UTL_LinkedList *list) {
-    if (list->count == 0) return NULL;
-
-    return UTL_ListPos2Obj(list, list->sentinel.next->obj);
-}
+static void UTL_UnrolledListUnlinkChunk(UTL_UnrolledList *list, UTL_UnrolledListChunk *chunk) {
+    if (chunk->prev) chunk->prev->next = chunk->next;
+    else             list->head = chunk->next;
 
+    if (chunk->next) chunk->next->prev = chunk->prev;
+    else             list->tail = chunk->prev;
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    free(chunk);
+}
 
 
-static void UTL_ArrayListPushBack(UTL_ArrayList *list, void *obj) {
+/* find the chunk holding the object at index @at, skipping whole chunks from the nearer end of the list.
+ * the object's index inside the chunk is stored in @offset */
+static UTL_UnrolledListChunk* UTL_UnrolledListLocate(UTL_UnrolledList *list, int at, int *offset) {
+    UTL_UnrolledListChunk *chunk;
 
-    if (list->count == list->capacity) {
-        list->capacity += list->capacity >> 1;
-        list->data = realloc(list->data, UTL_ListDataSize(list) * list->capacity);
+    if (at < list->count / 2) {
+        chunk = list->head;
+        while (at >= chunk->count) {
+            at -= chunk->count;
+            chunk = chunk->next;
+        }
+    }
+    else {
+        int fromBack = list->count - at;
+        chunk = list->tail;
+        while (fromBack > chunk->count) {
+            fromBack -= chunk->count;
+            chunk = chunk->prev;
+        }
+        at = chunk->count - fromBack;
     }
 
-    uint8_t *pos = list->data + UTL_ListDataSize(list) * list->count;
-    memcpy(pos, UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
-    
-    list->count++;
+    *offset = at;
+    return chunk;
 }
 
 
-static void UTL_LinkedListPushBack(UTL_LinkedList *list, void *obj) {
 
-    UTL_LinkedListNode *node = malloc(sizeof(UTL_LinkedListNode) + UTL_ListDataSize(list));
-    memcpy(node->obj, UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+// tree list nodes ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    node->next = &list->sentinel;
-    node->prev = list->sentinel.prev;
 
-    list->sentinel.prev->next = node;
-    list->sentinel.prev = node;
+/* allocate an empty leaf and link it in behind @prev, or at the front if @prev is NULL */
+static UTL_TreeListLeaf* UTL_TreeListLinkLeaf(UTL_TreeList *list, UTL_TreeListLeaf *prev) {
+    UTL_TreeListLeaf *leaf = malloc(sizeof(UTL_TreeListLeaf) + UTL_ListDataSize(list) * list->leafCapacity);
+    leaf->node.parent = NULL;
+    leaf->node.size   = 0;
+    leaf->node.isLeaf = true;
 
-    list->count++;
+    leaf->prev = prev;
+    leaf->next = prev ? prev->next : list->head;
+
+    if (leaf->next) leaf->next->prev = leaf;
+    else            list->tail = leaf;
+
+    if (prev) prev->next = leaf;
+    else      list->head = leaf;
+
+    return leaf;
 }
 
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void UTL_TreeListUnlinkLeaf(UTL_TreeList *list, UTL_TreeListLeaf *leaf) {
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else            list->head = leaf->next;
 
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else            list->tail = leaf->prev;
 
-static UTL_ListIter UTL_ArrayListGetIteratorAt(UTL_ArrayList *list, int at) {
-    return (UTL_ListIter) {
-        .list    = (UTL_List*) list,
-        .auxData = NULL,
-        .index   = at
-    };
+    free(leaf);
 }
 
 
-static UTL_ListIter UTL_LinkedListGetIteratorAt(UTL_LinkedList *list, int at) {
-    int forwardSteps  = at + 1;
-    int backwardSteps = list->count - at;
+static UTL_TreeListInner* UTL_TreeListNewInner(void) {
+    UTL_TreeListInner *inner = malloc(sizeof(UTL_TreeListInner));
+    inner->node.parent = NULL;
+    inner->node.size   = 0;
+    inner->node.isLeaf = false;
+    return inner;
+}
 
-    UTL_LinkedListNode *node = &list->sentinel;
-    if (forwardSteps < backwardSteps) while (forwardSteps--) node = node->next;
-    else                              while (backwardSteps--) node = node->prev;
 
-    return (UTL_ListIter) {
-        .list    = (UTL_List*) list,
-        .auxData = node,
-        .index   = at
-    };
+static int UTL_TreeListChildIndex(UTL_TreeListInner *parent, UTL_TreeListNode *child) {
+    int i = 0;
+    while (parent->children[i] != child) i++;
+    return i;
 }
 
 
-// abstract list functions ////////////////////////////////////////////////////////////////////////////////////////////
+/* number of objects below a node */
+static int UTL_TreeListNodeCount(UTL_TreeListNode *node) {
+    if (node->isLeaf) return node->size;
 
+    int count = 0;
+    for (int i = 0; i < node->size; i++)
+        count += ((UTL_TreeListInner*) node)->counts[i];
+    return count;
+}
 
-/** free the memory associated with the given list */
-void UTL_ListDestroy(UTL_List *list) {
-    switch (list->listType) {
-        case UTL_ARRAY_LIST:
-            UTL_ArrayListDestroy((UTL_ArrayList*) list);
-            break;
-        case UTL_LINKED_LIST:
-            UTL_LinkedListDestroy((UTL_LinkedList*) list);
-            break;
-        default:
-            break;
+
+/* add @delta to the object counts on the path from @node up to the root */
+static void UTL_TreeListAddCount(UTL_TreeListNode *node, int delta) {
+    while (node->parent) {
+        UTL_TreeListInner *parent = node->parent;
+        parent->counts[UTL_TreeListChildIndex(parent, node)] += delta;
+        node = &parent->node;
     }
 }
 
 
-/** get object at given index from a list */
-void* UTL_ListGet(UTL_List *list, int at) {
-    switch (list->listType) {
-        case UTL_ARRAY_LIST:
-            return UTL_ArrayListGet((UTL_ArrayList*) list, at);
-        case UTL_LINKED_LIST:
-            return UTL_LinkedListGet((UTL_LinkedList*) list, at);
-        default:
-            return NULL;
+static void UTL_TreeListAddSibling(UTL_TreeList *list, UTL_TreeListNode *node, UTL_TreeListNode *sibling);
+
+
+/* move the upper half of the children of a full inner node to a new sibling, returns the sibling */
+static UTL_TreeListInner* UTL_TreeListSplitInner(UTL_TreeList *list, UTL_TreeListInner *inner) {
+    UTL_TreeListInner *right = UTL_TreeListNewInner();
+    int half = inner->node.size / 2;
+
+    right->node.size = inner->node.size - half;
+    inner->node.size = half;
+    memcpy(right->children, inner->children + half, sizeof(UTL_TreeListNode*) * right->node.size);
+    memcpy(right->counts,   inner->counts   + half, sizeof(int) * right->node.size);
+
+    for (int i = 0; i < right->node.size; i++)
+        right->children[i]->parent = right;
+
+    UTL_TreeListAddSibling(list, &inner->node, &right->node);
+    return right;
+}
+
+
+/* hook @sibling into the tree right behind @node, which just handed some of its objects or children over to it.
+ * splits the parent if it is full, and grows the tree by one level when splitting the root */
+static void UTL_TreeListAddSibling(UTL_TreeList *list, UTL_TreeListNode *node, UTL_TreeListNode *sibling) {
+    UTL_TreeListInner *parent = node->parent;
+
+    if (!parent) {
+        parent = UTL_TreeListNewInner();
+        parent->node.size   = 1;
+        parent->children[0] = node;
+        node->parent = parent;
+
+        list->root = &parent->node;
+        list->height++;
+    }
+    else if (parent->node.size == UTL_TREE_LIST_FANOUT) {
+        UTL_TreeListInner *right = UTL_TreeListSplitInner(list, parent);
+        if (node->parent == right) parent = right;
     }
+
+    int at = UTL_TreeListChildIndex(parent, node) + 1;
+    memmove(parent->children + at + 1, parent->children + at, sizeof(UTL_TreeListNode*) * (parent->node.size - at));
+    memmove(parent->counts   + at + 1, parent->counts   + at, sizeof(int) * (parent->node.size - at));
+
+    parent->counts[at - 1] = UTL_TreeListNodeCount(node);
+    parent->counts[at]     = UTL_TreeListNodeCount(sibling);
+    parent->children[at]   = sibling;
+    parent->node.size++;
+    sibling->parent = parent;
 }
 
-/** get the last objet from a list */
-void* UTL_ListGetBack(UTL_List *list) {
-    switch (list->listType) {
-        case UTL_ARRAY_LIST:
-            return UTL_ArrayListGetBack((UTL_ArrayList*) list);
-        case UTL_LINKED_LIST:
-            return UTL_LinkedListGetBack((UTL_LinkedList*) list);
-        default:
-            return NULL;
+
+/* move @n objects or children from the front of the child @l+1 of @parent to the end of its child @l,
+ * or -@n of them the other way round if @n is negative */
+static void UTL_TreeListShift(UTL_TreeList *list, UTL_TreeListInner *parent, int l, int n) {
+    UTL_TreeListNode *left  = parent->children[l];
+    UTL_TreeListNode *right = parent->children[l + 1];
+    int moved = 0; // number of objects moved from right to left
+
+    if (left->isLeaf) {
+        size_t dataSize = UTL_ListDataSize(list);
+        uint8_t *leftData  = ((UTL_TreeListLeaf*) left)->data;
+        uint8_t *rightData = ((UTL_TreeListLeaf*) right)->data;
+
+        if (n > 0) {
+            memcpy(leftData + dataSize * left->size, rightData, dataSize * n);
+            memmove(rightData, rightData + dataSize * n, dataSize * (right->size - n));
+        }
+        else {
+            memmove(rightData - dataSize * n, rightData, dataSize * right->size);
+            memcpy(rightData, leftData + dataSize * (left->size + n), dataSize * -n);
+        }
+        moved = n;
     }
+    else {
+        UTL_TreeListInner *leftInner  = (UTL_TreeListInner*) left;
+        UTL_TreeListInner *rightInner = (UTL_TreeListInner*) right;
+
+        if (n > 0) {
+            memcpy(leftInner->children + left->size, rightInner->children, sizeof(UTL_TreeListNode*) * n);
+            memcpy(leftInner->counts   + left->size, rightInner->counts,   sizeof(int) * n);
+            memmove(rightInner->children, rightInner->children + n, sizeof(UTL_TreeListNode*) * (right->size - n));
+            memmove(rightInner->counts,   rightInner->counts   + n, sizeof(int) * (right->size - n));
+
+            for (int i = left->size; i < left->size + n; i++) {
+                leftInner->children[i]->parent = leftInner;
+                moved += leftInner->counts[i];
+            }
+        }
+        else {
+            memmove(rightInner->children - n, rightInner->children, sizeof(UTL_TreeListNode*) * right->size);
+            memmove(rightInner->counts   - n, rightInner->counts,   sizeof(int) * right->size);
+            memcpy(rightInner->children, leftInner->children + left->size + n, sizeof(UTL_TreeListNode*) * -n);
+            memcpy(rightInner->counts,   leftInner->counts   + left->size + n, sizeof(int) * -n);
+
+            for (int i = 0; i < -n; i++) {
+                rightInner->children[i]->parent = rightInner;
+                moved -= rightInner->counts[i];
+            }
+        }
+    }
+
+    left->size  += n;
+    right->size -= n;
+    parent->counts[l]     += moved;
+    parent->counts[l + 1] -= moved;
 }
 
 
-/** get the first object from a list */
-void* UTL_ListGetFront(UTL_List *list) {
-    switch (list->listType) {
-        case UTL_ARRAY_LIST:
-            return UTL_ArrayListGetFront((UTL_ArrayList*) list);
-        case UTL_LINKED_LIST:
-            return UTL_LinkedListGetFront((UTL_LinkedList*) list);
-        default:
-            return NULL;
+static void UTL_TreeListFreeNode(UTL_TreeListNode *node) {
+    if (!node->isLeaf) {
+        for (int i = 0; i < node->size; i++)
+            UTL_TreeListFreeNode(((UTL_TreeListInner*) node)->children[i]);
     }
+    free(node);
 }
 
 
-/** set object at given index in a list */
-void UTL_ListSet(UTL_List *list, int at, void *obj) {
-    (void) list;
-    (void) at;
-    (void) obj;
+/* free the inner nodes below and including @node, leaving the leaves alone */
+static void UTL_TreeListFreeInner(UTL_TreeListNode *node) {
+    if (node->isLeaf) return;
+
+    for (int i = 0; i < node->size; i++)
+        UTL_TreeListFreeInner(((UTL_TreeListInner*) node)->children[i]);
+    free(node);
 }
 
 
-/** append a new object to the back of the list */
-void UTL_ListPushBack(UTL_List *list, void *obj) {
-    switch (list->listType) {
-        case UTL_ARRAY_LIST:
-            UTL_ArrayListPushBack((UTL_ArrayList*) list, obj);
-            break;
-        case UTL_LINKED_LIST:
-            UTL_LinkedListPushBack((UTL_LinkedList*) list, obj);
-            break;
-        default:
-            break;
+/* build the inner nodes of a tree list bottom up from its chain of leaves, spreading the children of every
+ * level evenly over as few nodes as possible. any previous inner nodes have to be freed already */
+static void UTL_TreeListBuildIndex(UTL_TreeList *list) {
+    int n = 0;
+    for (UTL_TreeListLeaf *leaf = list->head; leaf; leaf = leaf->next) n++;
+
+    UTL_TreeListNode **level = malloc(sizeof(UTL_TreeListNode*) * n);
+    n = 0;
+    for (UTL_TreeListLeaf *leaf = list->head; leaf; leaf = leaf->next) {
+        leaf->node.parent = NULL;
+        level[n++] = &leaf->node;
     }
-}
 
+    list->height = 0;
+    while (n > 1) {
+        int numParents = (n + UTL_TREE_LIST_FANOUT - 1) / UTL_TREE_LIST_FANOUT;
+
+        // every parent takes at least one child, so the parents never overwrite unread children
+        for (int p = 0, c = 0; p < numParents; p++) {
+            UTL_TreeListInner *inner = UTL_TreeListNewInner();
+            int end = (int) ((long long) n * (p + 1) / numParents);
+
+            for (; c < end; c++) {
+                inner->children[inner->node.size] = level[c];
+                inner->counts[inner->node.size]   = UTL_TreeListNodeCount(level[c]);
+                inner->node.size++;
+                level[c]->parent = inner;
+            }
+            level[p] = &inner->node;
+        }
 
-/** prepend a new object to the front of the list */
-void UTL_ListPushFront(UTL_List *list, void *obj) {
-    (void) list;
-    (void) obj;
+        n = numParents;
+        list->height++;
+    }
+
+    list->root = level[0];
+    free(level);
 }
 
 
-/** append a new object to the back of the list */
-void UTL_ListInsert(UTL_List *list, int at, void *obj) {
-    (void) list;
-    (void) at;
-    (void) obj;
+/* a node fell below a quarter of its capacity -> merge it with a sibling if both fit into one node,
+ * otherwise even out the two. merging may leave the parent underfull in turn, or shrink the tree by one level */
+static void UTL_TreeListRebalance(UTL_TreeList *list, UTL_TreeListNode *node) {
+    UTL_TreeListInner *parent = node->parent;
+    if (!parent || parent->node.size < 2) return;
+
+    int capacity = node->isLeaf ? list->leafCapacity : UTL_TREE_LIST_FANOUT;
+    int at = UTL_TreeListChildIndex(parent, node);
+    int l  = at + 1 < parent->node.size ? at : at - 1;
+    UTL_TreeListNode *left  = parent->children[l];
+    UTL_TreeListNode *right = parent->children[l + 1];
+
+    if (left->size + right->size > capacity) {
+        UTL_TreeListShift(list, parent, l, (right->size - left->size) / 2);
+        return;
+    }
+
+    UTL_TreeListShift(list, parent, l, right->size);
+    if (right->isLeaf) UTL_TreeListUnlinkLeaf(list, (UTL_TreeListLeaf*) right);
+    else               free(right);
+
+    parent->node.size--;
+    memmove(parent->children + l + 1, parent->children + l + 2, sizeof(UTL_TreeListNode*) * (parent->node.size - l - 1));
+    memmove(parent->counts   + l + 1, parent->counts   + l + 2, sizeof(int) * (parent->node.size - l - 1));
+
+    if (!parent->node.parent) {
+        if (parent->node.size == 1) {
+            list->root = left;
+            left->parent = NULL;
+            list->height--;
+            free(parent);
+        }
+    }
+    else if (parent->node.size < UTL_TREE_LIST_FANOUT / 4) {
+        UTL_TreeListRebalance(list, &parent->node);
+    }
 }
 
 
-/** remove the last object from a list */
-void UTL_ListPopBack(UTL_List *list) {
-    if (!list->count) return;
-    UTL_ListRemove(list, list->count-1);
+/* find the leaf holding the object at index @at by descending from the root along the object counts.
+ * the object's index inside the leaf is stored in @offset. @at == count locates the end of the last leaf */
+static UTL_TreeListLeaf* UTL_TreeListLocate(UTL_TreeList *list, int at, int *offset) {
+    UTL_TreeListNode *node = list->root;
+
+    while (!node->isLeaf) {
+        UTL_TreeListInner *inner = (UTL_TreeListInner*) node;
+        int i = 0;
+        while (i < inner->node.size - 1 && at >= inner->counts[i]) {
+            at -= inner->counts[i];
+            i++;
+        }
+        node = inner->children[i];
+    }
+
+    *offset = at;
+    return (UTL_TreeListLeaf*) node;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/** remove the first object from a list */
-void UTL_ListPopFront(UTL_List *list) {
-    if (!list->count) return;
-    UTL_ListRemove(list, 0);
+
+/* release the buffer of an array list, which is freed if it is on the heap and unmapped if it is in a file mapping */
+static void UTL_ArrayListFreeData(UTL_ArrayList *list) {
+    if (list->mapping) {
+        UTL_UnmapFile(list->mapping, list->mappingSize);
+        list->mapping = NULL;
+    }
+    else if (list->data != list->inlineData) {
+        free(list->data);
+    }
 }
 
 
-/** remove the object at index @at from the list */
-void UTL_ListRemove(UTL_List *list, int at) {
-    UTL_ListIter iter = UTL_ListGetIteratorAt(list, at);
-    UTL_ListIterRemove(&iter);
+static void UTL_ArrayListDestroy(UTL_ArrayList *list) {
+    UTL_ArrayListFreeData(list);
+    free(list);
 }
 
 
-/** find the first index of the given object, at or after @offset */
-int UTL_ListFindFirst(UTL_List *list, void *obj, int offset) {
-    (void) list;
-    (void) obj;
-    (void) offset;
-    return -1;
+static void UTL_LinkedListDestroy(UTL_LinkedList *list) {
+    if (list->pool == &list->ownPool) {
+        UTL_ListNodePoolFreeSlabs(&list->ownPool);
+    }
+    else {
+        // other lists still allocate from the pool -> hand the nodes back one by one
+        UTL_LinkedListNode *node = list->sentinel.next;
+        while (node != &list->sentinel) {
+            UTL_LinkedListNode *next = node->next;
+            UTL_ListNodePoolFree(list->pool, node);
+            node = next;
+        }
+        UTL_ListNodePoolRelease(list->pool);
+    }
+    free(list);
 }
 
 
-/** find the last index of the given object, at or before @offset */
-int UTL_ListFindLast(UTL_List *list, void *obj, int offset) {
-    (void) list;
-    (void) obj;
-    (void) offset;
-    return -1;
+static void UTL_DequeListDestroy(UTL_DequeList *list) {
+    free(list->data);
+    free(list);
+}
+
+
+static void UTL_TreeListDestroy(UTL_TreeList *list) {
+    UTL_TreeListFreeNode(list->root);
+    free(list);
+}
+
+
+static void UTL_UnrolledListDestroy(UTL_UnrolledList *list) {
+    UTL_UnrolledListChunk *chunk = list->head;
+    while (chunk) {
+        UTL_UnrolledListChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(list);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void* UTL_ArrayListGet(UTL_ArrayList *list, int at) {
+
+    if (at < 0 || at >= list->count) return NULL;
+
+    uint8_t *pos = list->data + UTL_ListDataSize(list) * at;
+    return UTL_ListPos2Obj(list, pos);
+}
+
+
+void* UTL_LinkedListGet(UTL_LinkedList *list, int at) {
+
+    if (at < 0 || at >= list->count) return NULL;
+
+    UTL_LinkedListNode *node = list->sentinel.next;
+    while (at--) node = node->next;
+
+    return UTL_ListPos2Obj(list, node->obj);
+}
+
+
+void* UTL_DequeListGet(UTL_DequeList *list, int at) {
+
+    if (at < 0 || at >= list->count) return NULL;
+
+    return UTL_ListPos2Obj(list, UTL_DequeListAt(list, at));
+}
+
+
+void* UTL_TreeListGet(UTL_TreeList *list, int at) {
+
+    if (at < 0 || at >= list->count) return NULL;
+
+    int offset;
+    UTL_TreeListLeaf *leaf = UTL_TreeListLocate(list, at, &offset);
+    return UTL_ListPos2Obj(list, UTL_TreeListAt(list, leaf, offset));
+}
+
+
+void* UTL_UnrolledListGet(UTL_UnrolledList *list, int at) {
+
+    if (at < 0 || at >= list->count) return NULL;
+
+    int offset;
+    UTL_UnrolledListChunk *chunk = UTL_UnrolledListLocate(list, at, &offset);
+    return UTL_ListPos2Obj(list, UTL_UnrolledListAt(list, chunk, offset));
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void* UTL_ArrayListGetBack(UTL_ArrayList *list) {
+    if (list->count == 0) return NULL;
+
+    uint8_t *pos = list->data + UTL_ListDataSize(list) * (list->count - 1);
+    return UTL_ListPos2Obj(list, pos);
+}
+
+
+void* UTL_LinkedListGetBack(UTL_LinkedList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, list->sentinel.prev->obj);
+}
+
+
+void* UTL_DequeListGetBack(UTL_DequeList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, UTL_DequeListAt(list, list->count - 1));
+}
+
+
+void* UTL_TreeListGetBack(UTL_TreeList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, UTL_TreeListAt(list, list->tail, list->tail->node.size - 1));
+}
+
+
+void* UTL_UnrolledListGetBack(UTL_UnrolledList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, UTL_UnrolledListAt(list, list->tail, list->tail->count - 1));
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+void* UTL_ArrayListGetFront(UTL_ArrayList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, list->data);
+}
+
+
+void* UTL_LinkedListGetFront(UTL_LinkedList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, list->sentinel.next->obj);
+}
+
+
+void* UTL_DequeListGetFront(UTL_DequeList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, UTL_DequeListAt(list, 0));
+}
+
+
+void* UTL_TreeListGetFront(UTL_TreeList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, UTL_TreeListAt(list, list->head, 0));
+}
+
+
+void* UTL_UnrolledListGetFront(UTL_UnrolledList *list) {
+    if (list->count == 0) return NULL;
+
+    return UTL_ListPos2Obj(list, list->head->data);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* resize the buffer of an array list to @capacity objects, releasing it for a capacity of 0.
+ * capacities the inline buffer can hold move the objects back into it */
+static void UTL_ArrayListSetCapacity(UTL_ArrayList *list, int capacity) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    if (list->inlineCapacity > 0 && capacity <= list->inlineCapacity) {
+        if (list->data != list->inlineData) {
+            memcpy(list->inlineData, list->data, dataSize * list->count);
+            free(list->data);
+            list->data = list->inlineData;
+        }
+        capacity = list->inlineCapacity;
+    }
+    else if (capacity == 0) {
+        UTL_ArrayListFreeData(list);
+        list->data = NULL;
+    }
+    else if (list->data == list->inlineData || list->mapping) {
+        // spill the inline buffer or the mapped file to the heap
+        uint8_t *data = malloc(dataSize * capacity);
+        memcpy(data, list->data, dataSize * list->count);
+        UTL_ArrayListFreeData(list);
+        list->data = data;
+    }
+    else {
+        list->data = realloc(list->data, dataSize * capacity);
+    }
+    list->capacity = capacity;
+}
+
+
+/* a list mapped from a file is read only, its objects move to the heap before they are changed in place.
+ * changes that grow the list move them anyway, as a mapped list has no spare capacity */
+static void UTL_ListMakeWritable(UTL_List *list) {
+    if (list->listType == UTL_ARRAY_LIST && ((UTL_ArrayList*) list)->mapping)
+        UTL_ArrayListSetCapacity((UTL_ArrayList*) list, list->count);
+}
+
+
+/* make room for at least @count objects, growing the buffer by half its size at a time */
+static void UTL_ArrayListGrow(UTL_ArrayList *list, int count) {
+    if (count <= list->capacity) return;
+
+    int capacity = list->capacity + (list->capacity >> 1);
+    if (capacity < UTL_ARRAY_LIST_INITIAL_CAPACITY) capacity = UTL_ARRAY_LIST_INITIAL_CAPACITY;
+    if (capacity < count) capacity = count;
+
+    UTL_ArrayListSetCapacity(list, capacity);
+}
+
+
+static void UTL_ArrayListPushBack(UTL_ArrayList *list, void *obj) {
+
+    UTL_ArrayListGrow(list, list->count + 1);
+
+    uint8_t *pos = list->data + UTL_ListDataSize(list) * list->count;
+    memcpy(pos, UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+    
+    list->count++;
+}
+
+
+/* link a new node holding @obj in front of @next */
+static UTL_LinkedListNode* UTL_LinkedListInsertBefore(UTL_LinkedList *list, UTL_LinkedListNode *next, void *obj) {
+
+    UTL_LinkedListNode *node = UTL_ListNodePoolAlloc(list->pool);
+    memcpy(node->obj, UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+
+    node->next = next;
+    node->prev = next->prev;
+
+    next->prev->next = node;
+    next->prev = node;
+
+    list->count++;
+    return node;
+}
+
+
+static void UTL_LinkedListPushBack(UTL_LinkedList *list, void *obj) {
+    UTL_LinkedListInsertBefore(list, &list->sentinel, obj);
+}
+
+
+/* move the objects of a deque into a new buffer of @capacity objects, unwrapping them to its beginning.
+ * @capacity has to be a power of two and at least the number of objects, a capacity of 0 releases the buffer */
+static void UTL_DequeListSetCapacity(UTL_DequeList *list, int capacity) {
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *data = capacity ? malloc(dataSize * capacity) : NULL;
+
+    if (list->count) {
+        int firstPart = list->capacity - list->head;
+        if (firstPart > list->count) firstPart = list->count;
+
+        memcpy(data, list->data + dataSize * list->head, dataSize * firstPart);
+        memcpy(data + dataSize * firstPart, list->data, dataSize * (list->count - firstPart));
+    }
+
+    free(list->data);
+    list->data     = data;
+    list->head     = 0;
+    list->capacity = capacity;
+}
+
+
+/* make room for at least @count objects, doubling the buffer as often as needed */
+static void UTL_DequeListGrow(UTL_DequeList *list, int count) {
+    if (count <= list->capacity) return;
+
+    int capacity = list->capacity ? list->capacity : UTL_DEQUE_LIST_INITIAL_CAPACITY;
+    while (capacity < count) capacity *= 2;
+
+    UTL_DequeListSetCapacity(list, capacity);
+}
+
+
+static void UTL_DequeListPushBack(UTL_DequeList *list, void *obj) {
+
+    UTL_DequeListGrow(list, list->count + 1);
+    memcpy(UTL_DequeListAt(list, list->count), UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+
+    list->count++;
+}
+
+
+static void UTL_DequeListPushFront(UTL_DequeList *list, void *obj) {
+
+    UTL_DequeListGrow(list, list->count + 1);
+    list->head = (list->head - 1) & (list->capacity - 1);
+    memcpy(UTL_DequeListAt(list, 0), UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+
+    list->count++;
+}
+
+
+static void UTL_TreeListPushBack(UTL_TreeList *list, void *obj) {
+    UTL_TreeListLeaf *leaf = list->tail;
+
+    if (leaf->node.size == list->leafCapacity) {
+        // appending -> start a new leaf instead of splitting the full one, leaving it full
+        UTL_TreeListLeaf *next = UTL_TreeListLinkLeaf(list, leaf);
+        UTL_TreeListAddSibling(list, &leaf->node, &next->node);
+        leaf = next;
+    }
+
+    memcpy(UTL_TreeListAt(list, leaf, leaf->node.size), UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+
+    leaf->node.size++;
+    list->count++;
+    UTL_TreeListAddCount(&leaf->node, 1);
+}
+
+
+static void UTL_UnrolledListPushBack(UTL_UnrolledList *list, void *obj) {
+
+    if (!list->tail || list->tail->count == list->chunkCapacity)
+        UTL_UnrolledListLinkChunk(list, list->tail);
+
+    UTL_UnrolledListChunk *chunk = list->tail;
+    memcpy(UTL_UnrolledListAt(list, chunk, chunk->count), UTL_ListObj2Pos(list, obj), UTL_ListDataSize(list));
+
+    chunk->count++;
+    list->count++;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static void UTL_ArrayListInsert(UTL_ArrayList *list, int at, void *obj) {
+
+    UTL_ArrayListGrow(list, list->count + 1);
+
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *pos = list->data + dataSize * at;
+    memmove(pos + dataSize, pos, dataSize * (list->count - at));
+    memcpy(pos, UTL_ListObj2Pos(list, obj), dataSize);
+
+    list->count++;
+}
+
+
+static void UTL_ArrayListRemove(UTL_ArrayList *list, int at) {
+
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *pos = list->data + dataSize * at;
+    memmove(pos, pos + dataSize, dataSize * (list->count - at - 1));
+
+    list->count--;
+}
+
+
+/* unlink and free a node, returns the node that followed it */
+static UTL_LinkedListNode* UTL_LinkedListRemoveNode(UTL_LinkedList *list, UTL_LinkedListNode *node) {
+    UTL_LinkedListNode *next = node->next;
+
+    node->prev->next = next;
+    next->prev = node->prev;
+    UTL_ListNodePoolFree(list->pool, node);
+
+    list->count--;
+    return next;
+}
+
+
+/* insert @n objects stored at @objs at index @at, moving the objects on the shorter side of @at by @n */
+static void UTL_DequeListInsertRange(UTL_DequeList *list, int at, const uint8_t *objs, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    UTL_DequeListGrow(list, list->count + n);
+
+    if (at < list->count / 2) {
+        list->head = (list->head - n) & (list->capacity - 1);
+        for (int i = 0; i < at; i++)
+            memcpy(UTL_DequeListAt(list, i), UTL_DequeListAt(list, i + n), dataSize);
+    }
+    else {
+        for (int i = list->count - 1; i >= at; i--)
+            memcpy(UTL_DequeListAt(list, i + n), UTL_DequeListAt(list, i), dataSize);
+    }
+
+    // the new objects may wrap around the end of the buffer
+    int start = (list->head + at) & (list->capacity - 1);
+    int firstPart = list->capacity - start < n ? list->capacity - start : n;
+    memcpy(list->data + dataSize * start, objs, dataSize * firstPart);
+    memcpy(list->data, objs + dataSize * firstPart, dataSize * (n - firstPart));
+
+    list->count += n;
+}
+
+
+/* remove @n objects starting at index @at, moving the objects on the shorter side of the range by @n */
+static void UTL_DequeListRemoveRange(UTL_DequeList *list, int at, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    if (at < (list->count - n) / 2) {
+        for (int i = at - 1; i >= 0; i--)
+            memcpy(UTL_DequeListAt(list, i + n), UTL_DequeListAt(list, i), dataSize);
+        list->head = (list->head + n) & (list->capacity - 1);
+    }
+    else {
+        for (int i = at; i < list->count - n; i++)
+            memcpy(UTL_DequeListAt(list, i), UTL_DequeListAt(list, i + n), dataSize);
+    }
+
+    list->count -= n;
+}
+
+
+static void UTL_DequeListInsert(UTL_DequeList *list, int at, void *obj) {
+    UTL_DequeListInsertRange(list, at, UTL_ListObj2Pos(list, obj), 1);
+}
+
+
+static void UTL_DequeListRemove(UTL_DequeList *list, int at) {
+    UTL_DequeListRemoveRange(list, at, 1);
+}
+
+
+/* insert @obj at @offset into @leaf, splitting the leaf in halves if it is full.
+ * returns the leaf the new object ended up in, its index inside that leaf is stored in @offset */
+static UTL_TreeListLeaf* UTL_TreeListInsertAt(UTL_TreeList *list, UTL_TreeListLeaf *leaf, int *offset, void *obj) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    if (leaf->node.size == list->leafCapacity) {
+        UTL_TreeListLeaf *next = UTL_TreeListLinkLeaf(list, leaf);
+        int half = leaf->node.size / 2;
+
+        next->node.size = leaf->node.size - half;
+        leaf->node.size = half;
+        memcpy(next->data, UTL_TreeListAt(list, leaf, half), dataSize * next->node.size);
+        UTL_TreeListAddSibling(list, &leaf->node, &next->node);
+
+        if (*offset > half) {
+            *offset -= half;
+            leaf = next;
+        }
+    }
+
+    uint8_t *pos = UTL_TreeListAt(list, leaf, *offset);
+    memmove(pos + dataSize, pos, dataSize * (leaf->node.size - *offset));
+    memcpy(pos, UTL_ListObj2Pos(list, obj), dataSize);
+
+    leaf->node.size++;
+    list->count++;
+    UTL_TreeListAddCount(&leaf->node, 1);
+    return leaf;
+}
+
+
+/* remove @n objects at @offset from @leaf, rebalancing the tree if the leaf fell below a quarter of its capacity */
+static void UTL_TreeListRemoveAt(UTL_TreeList *list, UTL_TreeListLeaf *leaf, int offset, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    uint8_t *pos = UTL_TreeListAt(list, leaf, offset);
+    memmove(pos, pos + dataSize * n, dataSize * (leaf->node.size - offset - n));
+
+    leaf->node.size -= n;
+    list->count     -= n;
+    UTL_TreeListAddCount(&leaf->node, -n);
+
+    if (leaf->node.size < list->leafCapacity / 4)
+        UTL_TreeListRebalance(list, &leaf->node);
+}
+
+
+/* insert @obj at @offset into @chunk, splitting the chunk in halves if it is full.
+ * returns the chunk the new object ended up in, its index inside that chunk is stored in @offset */
+static UTL_UnrolledListChunk* UTL_UnrolledListInsertAt(UTL_UnrolledList *list, UTL_UnrolledListChunk *chunk, int *offset, void *obj) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    if (chunk->count == list->chunkCapacity) {
+        UTL_UnrolledListChunk *next = UTL_UnrolledListLinkChunk(list, chunk);
+        int half = chunk->count / 2;
+
+        next->count  = chunk->count - half;
+        chunk->count = half;
+        memcpy(next->data, UTL_UnrolledListAt(list, chunk, half), dataSize * next->count);
+
+        if (*offset > half) {
+            *offset -= half;
+            chunk = next;
+        }
+    }
+
+    uint8_t *pos = UTL_UnrolledListAt(list, chunk, *offset);
+    memmove(pos + dataSize, pos, dataSize * (chunk->count - *offset));
+    memcpy(pos, UTL_ListObj2Pos(list, obj), dataSize);
+
+    chunk->count++;
+    list->count++;
+    return chunk;
+}
+
+
+/* remove @n objects at @offset from @chunk, merging chunks that became less than a quarter full with a neighbour.
+ * returns the chunk holding the object that followed the removed ones (or NULL), its index is stored in @offset */
+static UTL_UnrolledListChunk* UTL_UnrolledListRemoveAt(UTL_UnrolledList *list, UTL_UnrolledListChunk *chunk, int *offset, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    uint8_t *pos = UTL_UnrolledListAt(list, chunk, *offset);
+    memmove(pos, pos + dataSize * n, dataSize * (chunk->count - *offset - n));
+    chunk->count -= n;
+    list->count  -= n;
+
+    if (chunk->count == 0) {
+        UTL_UnrolledListChunk *next = chunk->next;
+        UTL_UnrolledListUnlinkChunk(list, chunk);
+        *offset = 0;
+        return next;
+    }
+
+    if (chunk->count < list->chunkCapacity / 4) {
+        UTL_UnrolledListChunk *next = chunk->next;
+        UTL_UnrolledListChunk *prev = chunk->prev;
+
+        if (next && chunk->count + next->count <= list->chunkCapacity) {
+            // pull the next chunk in, the following object stays where it is
+            memcpy(UTL_UnrolledListAt(list, chunk, chunk->count), next->data, dataSize * next->count);
+            chunk->count += next->count;
+            UTL_UnrolledListUnlinkChunk(list, next);
+        }
+        else if (prev && chunk->count + prev->count <= list->chunkCapacity) {
+            // push this chunk into the previous one
+            memcpy(UTL_UnrolledListAt(list, prev, prev->count), chunk->data, dataSize * chunk->count);
+            *offset += prev->count;
+            prev->count += chunk->count;
+            UTL_UnrolledListUnlinkChunk(list, chunk);
+            chunk = prev;
+        }
+    }
+
+    if (*offset == chunk->count) {
+        *offset = 0;
+        return chunk->next;
+    }
+
+    return chunk;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+static UTL_ListIter UTL_ArrayListGetIteratorAt(UTL_ArrayList *list, int at) {
+    return (UTL_ListIter) {
+        .list    = (UTL_List*) list,
+        .auxData = NULL,
+        .index   = at
+    };
+}
+
+
+static UTL_ListIter UTL_LinkedListGetIteratorAt(UTL_LinkedList *list, int at) {
+    int forwardSteps  = at + 1;
+    int backwardSteps = list->count - at;
+
+    UTL_LinkedListNode *node = &list->sentinel;
+    if (forwardSteps < backwardSteps) while (forwardSteps--) node = node->next;
+    else                              while (backwardSteps--) node = node->prev;
+
+    return (UTL_ListIter) {
+        .list    = (UTL_List*) list,
+        .auxData = node,
+        .index   = at
+    };
+}
+
+
+static UTL_ListIter UTL_DequeListGetIteratorAt(UTL_DequeList *list, int at) {
+    return (UTL_ListIter) {
+        .list    = (UTL_List*) list,
+        .auxData = NULL,
+        .index   = at
+    };
+}
+
+
+static UTL_ListIter UTL_TreeListGetIteratorAt(UTL_TreeList *list, int at) {
+    int offset;
+    UTL_TreeListLeaf *leaf = UTL_TreeListLocate(list, at, &offset);
+
+    return (UTL_ListIter) {
+        .list     = (UTL_List*) list,
+        .auxData  = leaf,
+        .auxIndex = offset,
+        .index    = at
+    };
+}
+
+
+static UTL_ListIter UTL_UnrolledListGetIteratorAt(UTL_UnrolledList *list, int at) {
+    int offset;
+    UTL_UnrolledListChunk *chunk = UTL_UnrolledListLocate(list, at, &offset);
+
+    return (UTL_ListIter) {
+        .list     = (UTL_List*) list,
+        .auxData  = chunk,
+        .auxIndex = offset,
+        .index    = at
+    };
+}
+
+
+// bulk operations ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* the bulk operations take their objects as laid out in storage:
+ * @n consecutive objects, or @n consecutive object pointers for lists storing objects by reference */
+
+
+static void UTL_ArrayListInsertRange(UTL_ArrayList *list, int at, const uint8_t *objs, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    UTL_ArrayListGrow(list, list->count + n);
+
+    uint8_t *pos = list->data + dataSize * at;
+    memmove(pos + dataSize * n, pos, dataSize * (list->count - at));
+    memcpy(pos, objs, dataSize * n);
+
+    list->count += n;
+}
+
+
+static void UTL_ArrayListRemoveRange(UTL_ArrayList *list, int at, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    uint8_t *pos = list->data + dataSize * at;
+    memmove(pos, pos + dataSize * n, dataSize * (list->count - at - n));
+
+    list->count -= n;
+}
+
+
+static void UTL_LinkedListInsertRange(UTL_LinkedList *list, int at, const uint8_t *objs, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    UTL_LinkedListNode *next = &list->sentinel;
+    if (at < list->count) next = UTL_LinkedListGetIteratorAt(list, at).auxData;
+
+    for (int i = 0; i < n; i++)
+        UTL_LinkedListInsertBefore(list, next, UTL_ListPos2Obj(list, objs + dataSize * i));
+}
+
+
+static void UTL_LinkedListRemoveRange(UTL_LinkedList *list, int at, int n) {
+    UTL_LinkedListNode *node = UTL_LinkedListGetIteratorAt(list, at).auxData;
+
+    while (n--) node = UTL_LinkedListRemoveNode(list, node);
+}
+
+
+/* fill up the last chunk and append new ones with one copy per chunk */
+static void UTL_UnrolledListPushBackN(UTL_UnrolledList *list, const uint8_t *objs, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    while (n > 0) {
+        if (!list->tail || list->tail->count == list->chunkCapacity)
+            UTL_UnrolledListLinkChunk(list, list->tail);
+
+        UTL_UnrolledListChunk *chunk = list->tail;
+        int k = list->chunkCapacity - chunk->count;
+        if (k > n) k = n;
+
+        memcpy(UTL_UnrolledListAt(list, chunk, chunk->count), objs, dataSize * k);
+        chunk->count += k;
+        list->count  += k;
+        objs += dataSize * k;
+        n    -= k;
+    }
+}
+
+
+static void UTL_UnrolledListInsertRange(UTL_UnrolledList *list, int at, const uint8_t *objs, int n) {
+    if (at == list->count) {
+        UTL_UnrolledListPushBackN(list, objs, n);
+        return;
+    }
+
+    size_t dataSize = UTL_ListDataSize(list);
+    int offset;
+    UTL_UnrolledListChunk *chunk = UTL_UnrolledListLocate(list, at, &offset);
+
+    for (int i = 0; i < n; i++) {
+        chunk = UTL_UnrolledListInsertAt(list, chunk, &offset, UTL_ListPos2Obj(list, objs + dataSize * i));
+        offset++;
+    }
+}
+
+
+/* remove the range chunk by chunk, with one move per chunk */
+static void UTL_UnrolledListRemoveRange(UTL_UnrolledList *list, int at, int n) {
+    int offset;
+    UTL_UnrolledListChunk *chunk = UTL_UnrolledListLocate(list, at, &offset);
+
+    while (n > 0) {
+        int k = chunk->count - offset;
+        if (k > n) k = n;
+
+        chunk = UTL_UnrolledListRemoveAt(list, chunk, &offset, k);
+        n -= k;
+    }
+}
+
+
+/* fill up the last leaf and append new ones with one copy per leaf */
+static void UTL_TreeListPushBackN(UTL_TreeList *list, const uint8_t *objs, int n) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    while (n > 0) {
+        UTL_TreeListLeaf *leaf = list->tail;
+        if (leaf->node.size == list->leafCapacity) {
+            UTL_TreeListLeaf *next = UTL_TreeListLinkLeaf(list, leaf);
+            UTL_TreeListAddSibling(list, &leaf->node, &next->node);
+            leaf = next;
+        }
+
+        int k = list->leafCapacity - leaf->node.size;
+        if (k > n) k = n;
+
+        memcpy(UTL_TreeListAt(list, leaf, leaf->node.size), objs, dataSize * k);
+        leaf->node.size += k;
+        list->count     += k;
+        UTL_TreeListAddCount(&leaf->node, k);
+        objs += dataSize * k;
+        n    -= k;
+    }
+}
+
+
+static void UTL_TreeListInsertRange(UTL_TreeList *list, int at, const uint8_t *objs, int n) {
+    if (at == list->count) {
+        UTL_TreeListPushBackN(list, objs, n);
+        return;
+    }
+
+    size_t dataSize = UTL_ListDataSize(list);
+    int offset;
+    UTL_TreeListLeaf *leaf = UTL_TreeListLocate(list, at, &offset);
+
+    for (int i = 0; i < n; i++) {
+        leaf = UTL_TreeListInsertAt(list, leaf, &offset, UTL_ListPos2Obj(list, objs + dataSize * i));
+        offset++;
+    }
+}
+
+
+/* remove the range leaf by leaf, with one move per leaf */
+static void UTL_TreeListRemoveRange(UTL_TreeList *list, int at, int n) {
+    while (n > 0) {
+        int offset;
+        UTL_TreeListLeaf *leaf = UTL_TreeListLocate(list, at, &offset);
+
+        int k = leaf->node.size - offset;
+        if (k > n) k = n;
+
+        UTL_TreeListRemoveAt(list, leaf, offset, k);
+        n -= k;
+    }
+}
+
+
+/* copy all objects of a list, as laid out in storage, into one new array */
+static uint8_t* UTL_ListGather(UTL_List *list) {
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *data = malloc(dataSize * list->count);
+    uint8_t *pos = data;
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            memcpy(data, ((UTL_ArrayList*) list)->data, dataSize * list->count);
+            break;
+        case UTL_LINKED_LIST: {
+            UTL_LinkedList *linked = (UTL_LinkedList*) list;
+            for (UTL_LinkedListNode *node = linked->sentinel.next; node != &linked->sentinel; node = node->next) {
+                memcpy(pos, node->obj, dataSize);
+                pos += dataSize;
+            }
+            break;
+        }
+        case UTL_DEQUE_LIST:
+            for (int i = 0; i < list->count; i++)
+                memcpy(data + dataSize * i, UTL_DequeListAt(((UTL_DequeList*) list), i), dataSize);
+            break;
+        case UTL_UNROLLED_LIST:
+            for (UTL_UnrolledListChunk *chunk = ((UTL_UnrolledList*) list)->head; chunk; chunk = chunk->next) {
+                memcpy(pos, chunk->data, dataSize * chunk->count);
+                pos += dataSize * chunk->count;
+            }
+            break;
+        case UTL_TREE_LIST:
+            for (UTL_TreeListLeaf *leaf = ((UTL_TreeList*) list)->head; leaf; leaf = leaf->next) {
+                memcpy(pos, leaf->data, dataSize * leaf->node.size);
+                pos += dataSize * leaf->node.size;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return data;
+}
+
+
+// compaction /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* move the objects of a linked list into adjacent nodes in list order.
+ * a private pool is replaced by a single slab holding exactly the list's nodes, with a shared pool the nodes are
+ * taken as one run from the pool's newest slab and the old nodes are recycled */
+static void UTL_LinkedListCompact(UTL_LinkedList *list) {
+    UTL_ListNodePool *pool = list->pool;
+    bool ownPool = pool == &list->ownPool;
+
+    if (list->count == 0) {
+        if (ownPool) UTL_ListNodePoolFreeSlabs(pool);
+        return;
+    }
+
+    UTL_ListNodeSlab *slab = NULL;
+    uint8_t *pos;
+    if (ownPool) {
+        slab = malloc(sizeof(UTL_ListNodeSlab) + pool->nodeSize * list->count);
+        slab->numNodes = list->count;
+        slab->next     = NULL;
+        pos = slab->nodes;
+    }
+    else {
+        pos = UTL_ListNodePoolAllocRun(pool, list->count);
+    }
+
+    UTL_LinkedListNode *prev = &list->sentinel;
+    UTL_LinkedListNode *node = list->sentinel.next;
+    while (node != &list->sentinel) {
+        UTL_LinkedListNode *next = node->next;
+        UTL_LinkedListNode *copy = (UTL_LinkedListNode*) pos;
+
+        memcpy(copy->obj, node->obj, UTL_ListDataSize(list));
+        copy->prev = prev;
+        prev->next = copy;
+        if (!ownPool) UTL_ListNodePoolFree(pool, node);
+
+        prev = copy;
+        node = next;
+        pos += pool->nodeSize;
+    }
+    prev->next = &list->sentinel;
+    list->sentinel.prev = prev;
+
+    if (ownPool) {
+        UTL_ListNodePoolFreeSlabs(pool);
+        pool->slabs = slab;
+    }
+}
+
+
+// filtering //////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* a filter pass keeps the objects it does not drop in their order, moving them to the front of the list */
+typedef struct {
+    UTL_List *list;                      // the filtered list
+    bool    (*predFunc)(void*, void*);   // predicate called with @aux and the object
+    void     *aux;                       // passed to @predFunc
+    bool      dropIf;                    // drop objects for which @predFunc returns this value
+    bool      unique;                    // instead drop objects comparing equal to the last kept one
+} UTL_ListFilter;
+
+
+/* decide whether to drop the object stored at @pos. @kept is the position of the last kept object, or NULL */
+static inline bool UTL_ListFilterDrops(const UTL_ListFilter *filter, uint8_t *kept, uint8_t *pos) {
+    UTL_List *list = filter->list;
+
+    if (filter->unique)
+        return kept && list->dataType->cmpFunc(UTL_ListPos2Obj(list, kept), UTL_ListPos2Obj(list, pos)) == 0;
+
+    return filter->predFunc(filter->aux, UTL_ListPos2Obj(list, pos)) == filter->dropIf;
+}
+
+
+static void UTL_ArrayListFilter(UTL_ArrayList *list, const UTL_ListFilter *filter) {
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *write = list->data;
+    uint8_t *end = list->data + dataSize * list->count;
+
+    for (uint8_t *read = list->data; read < end; read += dataSize) {
+        if (UTL_ListFilterDrops(filter, write == list->data ? NULL : write - dataSize, read)) continue;
+
+        if (write != read) memcpy(write, read, dataSize);
+        write += dataSize;
+    }
+
+    list->count = (int) ((write - list->data) / dataSize);
+}
+
+
+static void UTL_LinkedListFilter(UTL_LinkedList *list, const UTL_ListFilter *filter) {
+    uint8_t *kept = NULL;
+    UTL_LinkedListNode *node = list->sentinel.next;
+
+    while (node != &list->sentinel) {
+        if (UTL_ListFilterDrops(filter, kept, node->obj)) {
+            node = UTL_LinkedListRemoveNode(list, node);
+        }
+        else {
+            kept = node->obj;
+            node = node->next;
+        }
+    }
+}
+
+
+static void UTL_DequeListFilter(UTL_DequeList *list, const UTL_ListFilter *filter) {
+    size_t dataSize = UTL_ListDataSize(list);
+    int write = 0;
+
+    for (int read = 0; read < list->count; read++) {
+        uint8_t *pos = UTL_DequeListAt(list, read);
+        if (UTL_ListFilterDrops(filter, write ? UTL_DequeListAt(list, write - 1) : NULL, pos)) continue;
+
+        if (write != read) memcpy(UTL_DequeListAt(list, write), pos, dataSize);
+        write++;
+    }
+
+    list->count = write;
+}
+
+
+/* the kept objects refill the chunks from the front, keeping their sizes. chunks left empty are released */
+static void UTL_UnrolledListFilter(UTL_UnrolledList *list, const UTL_ListFilter *filter) {
+    size_t dataSize = UTL_ListDataSize(list);
+    UTL_UnrolledListChunk *writeChunk = list->head;
+    int writeOffset = 0;
+    uint8_t *kept = NULL;
+    int count = 0;
+
+    for (UTL_UnrolledListChunk *chunk = list->head; chunk; chunk = chunk->next) {
+        for (int i = 0; i < chunk->count; i++) {
+            uint8_t *pos = UTL_UnrolledListAt(list, chunk, i);
+            if (UTL_ListFilterDrops(filter, kept, pos)) continue;
+
+            if (writeOffset == writeChunk->count) {
+                writeChunk  = writeChunk->next;
+                writeOffset = 0;
+            }
+
+            kept = UTL_UnrolledListAt(list, writeChunk, writeOffset);
+            if (kept != pos) memcpy(kept, pos, dataSize);
+            writeOffset++;
+            count++;
+        }
+    }
+
+    while (writeChunk->next) UTL_UnrolledListUnlinkChunk(list, writeChunk->next);
+
+    writeChunk->count = writeOffset;
+    if (writeOffset == 0) UTL_UnrolledListUnlinkChunk(list, writeChunk);
+
+    list->count = count;
+}
+
+
+/* filter the leaves like the chunks of an unrolled list, then rebuild the inner nodes on top of them */
+static void UTL_TreeListFilter(UTL_TreeList *list, const UTL_ListFilter *filter) {
+    size_t dataSize = UTL_ListDataSize(list);
+    UTL_TreeListLeaf *writeLeaf = list->head;
+    int writeOffset = 0;
+    uint8_t *kept = NULL;
+    int count = 0;
+
+    for (UTL_TreeListLeaf *leaf = list->head; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->node.size; i++) {
+            uint8_t *pos = UTL_TreeListAt(list, leaf, i);
+            if (UTL_ListFilterDrops(filter, kept, pos)) continue;
+
+            if (writeOffset == writeLeaf->node.size) {
+                writeLeaf   = writeLeaf->next;
+                writeOffset = 0;
+            }
+
+            kept = UTL_TreeListAt(list, writeLeaf, writeOffset);
+            if (kept != pos) memcpy(kept, pos, dataSize);
+            writeOffset++;
+            count++;
+        }
+    }
+
+    UTL_TreeListFreeInner(list->root);
+
+    while (writeLeaf->next) UTL_TreeListUnlinkLeaf(list, writeLeaf->next);
+
+    // the first leaf stays, even if empty
+    writeLeaf->node.size = writeOffset;
+    if (writeOffset == 0 && writeLeaf != list->head) UTL_TreeListUnlinkLeaf(list, writeLeaf);
+
+    list->count = count;
+    UTL_TreeListBuildIndex(list);
+}
+
+
+/* run a filter pass over a list, returns the number of dropped objects */
+static int UTL_ListApplyFilter(UTL_List *list, const UTL_ListFilter *filter) {
+    int count = list->count;
+    if (count == 0) return 0;
+
+    UTL_ListMakeWritable(list);
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListFilter((UTL_ArrayList*) list, filter);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListFilter((UTL_LinkedList*) list, filter);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListFilter((UTL_DequeList*) list, filter);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListFilter((UTL_UnrolledList*) list, filter);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListFilter((UTL_TreeList*) list, filter);
+            break;
+        default:
+            break;
+    }
+
+    return count - list->count;
+}
+
+
+// searching //////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* the vectorized searches test blocks of 16 ints or floats, or 32 chars at a time.
+ * the match functions return a bit mask with bit i set if the i-th object of the block matches */
+
+#if defined(__AVX2__)
+
+static inline uint32_t UTL_MatchInt16(const int *pos, int value) {
+    __m256i needle = _mm256_set1_epi32(value);
+    __m256i lo = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) pos),       needle);
+    __m256i hi = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) (pos + 8)), needle);
+    return (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(lo)) | (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8;
+}
+
+/* equal or unordered, which is what UTL_TypeInfoFloat.cmpFunc reports as equal */
+static inline uint32_t UTL_MatchFloat16(const float *pos, float value) {
+    __m256 needle = _mm256_set1_ps(value);
+    __m256 lo = _mm256_cmp_ps(_mm256_loadu_ps(pos),     needle, _CMP_EQ_UQ);
+    __m256 hi = _mm256_cmp_ps(_mm256_loadu_ps(pos + 8), needle, _CMP_EQ_UQ);
+    return (uint32_t) _mm256_movemask_ps(lo) | (uint32_t) _mm256_movemask_ps(hi) << 8;
+}
+
+static inline uint32_t UTL_MatchChar32(const char *pos, char value) {
+    __m256i match = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) pos), _mm256_set1_epi8(value));
+    return (uint32_t) _mm256_movemask_epi8(match);
+}
+
+#elif defined(__SSE2__)
+
+static inline uint32_t UTL_MatchInt16(const int *pos, int value) {
+    __m128i needle = _mm_set1_epi32(value);
+    uint32_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i match = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (pos + 4 * i)), needle);
+        mask |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(match)) << (4 * i);
+    }
+    return mask;
+}
+
+/* equal or unordered, which is what UTL_TypeInfoFloat.cmpFunc reports as equal */
+static inline uint32_t UTL_MatchFloat16(const float *pos, float value) {
+    __m128 needle = _mm_set1_ps(value);
+    uint32_t mask = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128 block = _mm_loadu_ps(pos + 4 * i);
+        __m128 match = _mm_or_ps(_mm_cmpeq_ps(block, needle), _mm_cmpunord_ps(block, needle));
+        mask |= (uint32_t) _mm_movemask_ps(match) << (4 * i);
+    }
+    return mask;
+}
+
+static inline uint32_t UTL_MatchChar32(const char *pos, char value) {
+    __m128i needle = _mm_set1_epi8(value);
+    __m128i lo = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) pos),        needle);
+    __m128i hi = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (pos + 16)), needle);
+    return (uint32_t) _mm_movemask_epi8(lo) | (uint32_t) _mm_movemask_epi8(hi) << 16;
+}
+
+#else
+
+static inline uint32_t UTL_MatchInt16(const int *pos, int value) {
+    uint32_t mask = 0;
+    for (int i = 0; i < 16; i++) mask |= (uint32_t) (pos[i] == value) << i;
+    return mask;
+}
+
+static inline uint32_t UTL_MatchFloat16(const float *pos, float value) {
+    uint32_t mask = 0;
+    for (int i = 0; i < 16; i++) mask |= (uint32_t) (!(pos[i] < value) && !(pos[i] > value)) << i;
+    return mask;
+}
+
+static inline uint32_t UTL_MatchChar32(const char *pos, char value) {
+    uint32_t mask = 0;
+    for (int i = 0; i < 32; i++) mask |= (uint32_t) (pos[i] == value) << i;
+    return mask;
+}
+
+#endif
+
+
+/* first index in [@from, @to) of an int equal to @value, or -1 */
+static int UTL_SearchInt(const int *data, int from, int to, int value) {
+    int i = from;
+    for (; i + 16 <= to; i += 16) {
+        uint32_t mask = UTL_MatchInt16(data + i, value);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    for (; i < to; i++)
+        if (data[i] == value) return i;
+    return -1;
+}
+
+
+/* last index in [@from, @to) of an int equal to @value, or -1 */
+static int UTL_SearchLastInt(const int *data, int from, int to, int value) {
+    int i = to;
+    for (; i - 16 >= from; i -= 16) {
+        uint32_t mask = UTL_MatchInt16(data + i - 16, value);
+        if (mask) return i - 16 + 31 - __builtin_clz(mask);
+    }
+    for (; i > from; i--)
+        if (data[i - 1] == value) return i - 1;
+    return -1;
+}
+
+
+/* first index in [@from, @to) of a float comparing equal to @value, or -1 */
+static int UTL_SearchFloat(const float *data, int from, int to, float value) {
+    int i = from;
+    for (; i + 16 <= to; i += 16) {
+        uint32_t mask = UTL_MatchFloat16(data + i, value);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    for (; i < to; i++)
+        if (!(data[i] < value) && !(data[i] > value)) return i;
+    return -1;
+}
+
+
+/* last index in [@from, @to) of a float comparing equal to @value, or -1 */
+static int UTL_SearchLastFloat(const float *data, int from, int to, float value) {
+    int i = to;
+    for (; i - 16 >= from; i -= 16) {
+        uint32_t mask = UTL_MatchFloat16(data + i - 16, value);
+        if (mask) return i - 16 + 31 - __builtin_clz(mask);
+    }
+    for (; i > from; i--)
+        if (!(data[i - 1] < value) && !(data[i - 1] > value)) return i - 1;
+    return -1;
+}
+
+
+/* first index in [@from, @to) of @value, or -1 */
+static int UTL_SearchChar(const char *data, int from, int to, char value) {
+    const char *pos = memchr(data + from, value, to - from);
+    return pos ? (int) (pos - data) : -1;
+}
+
+
+/* last index in [@from, @to) of @value, or -1 */
+static int UTL_SearchLastChar(const char *data, int from, int to, char value) {
+    int i = to;
+    for (; i - 32 >= from; i -= 32) {
+        uint32_t mask = UTL_MatchChar32(data + i - 32, value);
+        if (mask) return i - 32 + 31 - __builtin_clz(mask);
+    }
+    for (; i > from; i--)
+        if (data[i - 1] == value) return i - 1;
+    return -1;
+}
+
+
+/* whether an object of the list equals @obj, using the compare function of the list's data type if it has one.
+ * otherwise objects stored by reference are compared by address, and objects stored by value byte by byte */
+static inline bool UTL_ListObjEquals(UTL_List *list, void *listObj, void *obj) {
+    if (list->dataType && list->dataType->cmpFunc) return list->dataType->cmpFunc(listObj, obj) == 0;
+    if (list->byRef) return listObj == obj;
+    return memcmp(listObj, obj, list->dataType->size) == 0;
+}
+
+
+// numeric reductions /////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* blocks of floats up to this size are summed directly by the pairwise summation */
+#define UTL_PAIRWISE_SUM_BLOCK 256
+
+
+/* sum of @n floats, using four vector accumulators to hide the latency of the additions */
+static double UTL_SumFloat(const float *data, int n) {
+    int i = 0;
+    double sum = 0.0;
+
+#if defined(__AVX2__)
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(data + i));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(data + i + 8));
+        acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(data + i + 16));
+        acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(data + i + 24));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+    for (int l = 0; l < 8; l++) sum += lanes[l];
+#elif defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm_add_ps(acc0, _mm_loadu_ps(data + i));
+        acc1 = _mm_add_ps(acc1, _mm_loadu_ps(data + i + 4));
+        acc2 = _mm_add_ps(acc2, _mm_loadu_ps(data + i + 8));
+        acc3 = _mm_add_ps(acc3, _mm_loadu_ps(data + i + 12));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+    for (int l = 0; l < 4; l++) sum += lanes[l];
+#endif
+
+    for (; i < n; i++) sum += data[i];
+    return sum;
+}
+
+
+/* pairwise sum of @n floats, the rounding error grows with log(n) instead of n */
+static double UTL_SumFloatPairwise(const float *data, int n) {
+    if (n <= UTL_PAIRWISE_SUM_BLOCK) return UTL_SumFloat(data, n);
+
+    int half = n / 2;
+    return UTL_SumFloatPairwise(data, half) + UTL_SumFloatPairwise(data + half, n - half);
+}
+
+
+/* exact sum of @n ints, widened to 64 bit lanes */
+static int64_t UTL_SumInt(const int *data, int n) {
+    int i = 0;
+    int64_t sum = 0;
+
+#if defined(__AVX2__)
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*) (data + i));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, _mm256_add_epi64(acc0, acc1));
+    for (int l = 0; l < 4; l++) sum += lanes[l];
+#elif defined(__SSE2__)
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        // sign extend to 64 bit by interleaving with the sign masks
+        __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+        __m128i sign  = _mm_cmpgt_epi32(_mm_setzero_si128(), block);
+        acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(block, sign));
+        acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(block, sign));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i*) lanes, _mm_add_epi64(acc0, acc1));
+    sum += lanes[0] + lanes[1];
+#endif
+
+    for (; i < n; i++) sum += data[i];
+    return sum;
+}
+
+
+/* smallest and largest of @n > 0 floats, NaNs are skipped unless there is nothing else */
+static void UTL_MinMaxFloat(const float *data, int n, float *min, float *max) {
+    // start from the first number, min/max instructions return their second operand if one is NaN
+    int i = 0;
+    while (i < n - 1 && data[i] != data[i]) i++;
+    float lo = data[i], hi = data[i];
+
+#if defined(__AVX2__)
+    __m256 vlo = _mm256_set1_ps(lo), vhi = _mm256_set1_ps(hi);
+    for (; i + 8 <= n; i += 8) {
+        __m256 block = _mm256_loadu_ps(data + i);
+        vlo = _mm256_min_ps(block, vlo);
+        vhi = _mm256_max_ps(block, vhi);
+    }
+    float lanesLo[8], lanesHi[8];
+    _mm256_storeu_ps(lanesLo, vlo);
+    _mm256_storeu_ps(lanesHi, vhi);
+    for (int l = 0; l < 8; l++) {
+        if (lanesLo[l] < lo) lo = lanesLo[l];
+        if (lanesHi[l] > hi) hi = lanesHi[l];
+    }
+#elif defined(__SSE2__)
+    __m128 vlo = _mm_set1_ps(lo), vhi = _mm_set1_ps(hi);
+    for (; i + 4 <= n; i += 4) {
+        __m128 block = _mm_loadu_ps(data + i);
+        vlo = _mm_min_ps(block, vlo);
+        vhi = _mm_max_ps(block, vhi);
+    }
+    float lanesLo[4], lanesHi[4];
+    _mm_storeu_ps(lanesLo, vlo);
+    _mm_storeu_ps(lanesHi, vhi);
+    for (int l = 0; l < 4; l++) {
+        if (lanesLo[l] < lo) lo = lanesLo[l];
+        if (lanesHi[l] > hi) hi = lanesHi[l];
+    }
+#endif
+
+    for (; i < n; i++) {
+        if (data[i] < lo) lo = data[i];
+        if (data[i] > hi) hi = data[i];
+    }
+
+    *min = lo;
+    *max = hi;
+}
+
+
+/* smallest and largest of @n > 0 ints */
+static void UTL_MinMaxInt(const int *data, int n, int *min, int *max) {
+    int i = 0;
+    int lo = data[0], hi = data[0];
+
+#if defined(__AVX2__)
+    __m256i vlo = _mm256_set1_epi32(lo), vhi = _mm256_set1_epi32(hi);
+    for (; i + 8 <= n; i += 8) {
+        __m256i block = _mm256_loadu_si256((const __m256i*) (data + i));
+        vlo = _mm256_min_epi32(vlo, block);
+        vhi = _mm256_max_epi32(vhi, block);
+    }
+    int lanesLo[8], lanesHi[8];
+    _mm256_storeu_si256((__m256i*) lanesLo, vlo);
+    _mm256_storeu_si256((__m256i*) lanesHi, vhi);
+    for (int l = 0; l < 8; l++) {
+        if (lanesLo[l] < lo) lo = lanesLo[l];
+        if (lanesHi[l] > hi) hi = lanesHi[l];
+    }
+#elif defined(__SSE2__)
+    // SSE2 has no 32 bit min/max -> select through compare masks
+    __m128i vlo = _mm_set1_epi32(lo), vhi = _mm_set1_epi32(hi);
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+        __m128i less    = _mm_cmplt_epi32(block, vlo);
+        __m128i greater = _mm_cmpgt_epi32(block, vhi);
+        vlo = _mm_or_si128(_mm_and_si128(less, block),    _mm_andnot_si128(less, vlo));
+        vhi = _mm_or_si128(_mm_and_si128(greater, block), _mm_andnot_si128(greater, vhi));
+    }
+    int lanesLo[4], lanesHi[4];
+    _mm_storeu_si128((__m128i*) lanesLo, vlo);
+    _mm_storeu_si128((__m128i*) lanesHi, vhi);
+    for (int l = 0; l < 4; l++) {
+        if (lanesLo[l] < lo) lo = lanesLo[l];
+        if (lanesHi[l] > hi) hi = lanesHi[l];
+    }
+#endif
+
+    for (; i < n; i++) {
+        if (data[i] < lo) lo = data[i];
+        if (data[i] > hi) hi = data[i];
+    }
+
+    *min = lo;
+    *max = hi;
+}
+
+
+/* dot product of @n floats each, using four vector accumulators */
+static double UTL_DotFloat(const float *data1, const float *data2, int n) {
+    int i = 0;
+    double dot = 0.0;
+
+#if defined(__AVX2__)
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(data1 + i),      _mm256_loadu_ps(data2 + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(data1 + i + 8),  _mm256_loadu_ps(data2 + i + 8)));
+        acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(_mm256_loadu_ps(data1 + i + 16), _mm256_loadu_ps(data2 + i + 16)));
+        acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(_mm256_loadu_ps(data1 + i + 24), _mm256_loadu_ps(data2 + i + 24)));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+    for (int l = 0; l < 8; l++) dot += lanes[l];
+#elif defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(data1 + i),      _mm_loadu_ps(data2 + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(data1 + i + 4),  _mm_loadu_ps(data2 + i + 4)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(data1 + i + 8),  _mm_loadu_ps(data2 + i + 8)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(data1 + i + 12), _mm_loadu_ps(data2 + i + 12)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3)));
+    for (int l = 0; l < 4; l++) dot += lanes[l];
+#endif
+
+    for (; i < n; i++) dot += (double) data1[i] * data2[i];
+    return dot;
+}
+
+
+/* exact dot product of @n ints each, multiplying into 64 bit lanes */
+static int64_t UTL_DotInt(const int *data1, const int *data2, int n) {
+    int i = 0;
+    int64_t dot = 0;
+
+#if defined(__AVX2__)
+    // _mm256_mul_epi32 multiplies the even lanes, the odd ones are shifted down to even positions
+    __m256i accEven = _mm256_setzero_si256(), accOdd = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8) {
+        __m256i block1 = _mm256_loadu_si256((const __m256i*) (data1 + i));
+        __m256i block2 = _mm256_loadu_si256((const __m256i*) (data2 + i));
+        accEven = _mm256_add_epi64(accEven, _mm256_mul_epi32(block1, block2));
+        accOdd  = _mm256_add_epi64(accOdd,  _mm256_mul_epi32(_mm256_srli_epi64(block1, 32), _mm256_srli_epi64(block2, 32)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*) lanes, _mm256_add_epi64(accEven, accOdd));
+    for (int l = 0; l < 4; l++) dot += lanes[l];
+#else
+    // SSE2 only multiplies unsigned 32 bit lanes, four scalar accumulators keep the multipliers busy instead
+    int64_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 += (int64_t) data1[i]     * data2[i];
+        acc1 += (int64_t) data1[i + 1] * data2[i + 1];
+        acc2 += (int64_t) data1[i + 2] * data2[i + 2];
+        acc3 += (int64_t) data1[i + 3] * data2[i + 3];
+    }
+    dot = acc0 + acc1 + acc2 + acc3;
+#endif
+
+    for (; i < n; i++) dot += (int64_t) data1[i] * data2[i];
+    return dot;
+}
+
+
+static void UTL_ScaleFloat(float *data, int n, float factor) {
+    int i = 0;
+
+#if defined(__AVX2__)
+    __m256 f = _mm256_set1_ps(factor);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), f));
+#elif defined(__SSE2__)
+    __m128 f = _mm_set1_ps(factor);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), f));
+#endif
+
+    for (; i < n; i++) data[i] *= factor;
+}
+
+
+/* scale one int, truncating toward zero. products out of the range of int and NaN give INT_MIN,
+ * like the truncating conversions of SSE2 and AVX2 do */
+static inline int UTL_ScaleIntValue(int value, double factor) {
+    double product = value * factor;
+    return product > (double) INT_MIN - 1.0 && product < (double) INT_MAX + 1.0 ? (int) product : INT_MIN;
+}
+
+
+/* multiply @n ints by @factor in double precision, truncating the results toward zero */
+static void UTL_ScaleInt(int *data, int n, double factor) {
+    int i = 0;
+
+#if defined(__AVX2__)
+    __m256d f = _mm256_set1_pd(factor);
+    for (; i + 4 <= n; i += 4) {
+        __m256d block = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*) (data + i)));
+        _mm_storeu_si128((__m128i*) (data + i), _mm256_cvttpd_epi32(_mm256_mul_pd(block, f)));
+    }
+#elif defined(__SSE2__)
+    __m128d f = _mm_set1_pd(factor);
+    for (; i + 4 <= n; i += 4) {
+        __m128i block = _mm_loadu_si128((const __m128i*) (data + i));
+        __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(block), f));
+        __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(block, 8)), f));
+        _mm_storeu_si128((__m128i*) (data + i), _mm_unpacklo_epi64(lo, hi));
+    }
+#endif
+
+    for (; i < n; i++) data[i] = UTL_ScaleIntValue(data[i], factor);
+}
+
+
+/* whether the numeric functions can work on the list's array directly */
+static inline bool UTL_ListIsNumericArray(UTL_List *list) {
+    return list->listType == UTL_ARRAY_LIST && !list->byRef &&
+           (list->dataType == &UTL_TypeInfoInt || list->dataType == &UTL_TypeInfoFloat);
+}
+
+
+// sorting ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* ranges smaller than this are sorted with insertion sort */
+#define UTL_SORT_INSERTION_THRESHOLD 24
+
+/* ranges larger than this use the median of three medians (ninther) as pivot */
+#define UTL_SORT_NINTHER_THRESHOLD 128
+
+/* maximum number of moves before a partial insertion sort gives up */
+#define UTL_SORT_PARTIAL_INSERTION_LIMIT 8
+
+/* ranges of primitives at least this large are radix sorted */
+#define UTL_SORT_RADIX_THRESHOLD 256
+
+/* length of the runs a stable sort creates with insertion sort, before merging them */
+#define UTL_SORT_STABLE_RUN_LENGTH 32
+
+
+
+/** everything the sort routines need to know about raw list data */
+typedef struct {
+    size_t       size;   // size of one stored object (size of a pointer if stored by reference)
+    UTL_CmpFunc *cmp;    // compare function of the stored type
+    bool         byRef;  // stored pointers are compared by the objects they point at
+    uint8_t     *tmp;    // scratch space for one stored object
+    uint8_t     *pivot;  // scratch space for one stored object, holds the pivot while partitioning
+} UTL_SortInfo;
+
+
+/* scratch space used by UTL_SortInfo for small objects, aligned for all primitive types */
+typedef union {
+    uint8_t     bytes[64];
+    void       *ptr;
+    long double ld;
+    long long   ll;
+} UTL_SortScratch;
+
+
+#define UTL_SortAt(sort, data, i) ((data) + (size_t)(i) * (sort)->size)
+
+
+static inline int UTL_SortCmp(const UTL_SortInfo *sort, const uint8_t *pos1, const uint8_t *pos2) {
+    if (sort->byRef) return sort->cmp(*(void* const*)pos1, *(void* const*)pos2);
+    return sort->cmp(pos1, pos2);
+}
+
+
+static inline void UTL_SortSwap(const UTL_SortInfo *sort, uint8_t *pos1, uint8_t *pos2) {
+    size_t size = sort->size;
+
+    while (size >= sizeof(uint64_t)) {
+        uint64_t tmp;
+        memcpy(&tmp, pos1, sizeof(uint64_t));
+        memcpy(pos1, pos2, sizeof(uint64_t));
+        memcpy(pos2, &tmp, sizeof(uint64_t));
+        pos1 += sizeof(uint64_t);
+        pos2 += sizeof(uint64_t);
+        size -= sizeof(uint64_t);
+    }
+
+    while (size--) {
+        uint8_t tmp = *pos1;
+        *pos1++ = *pos2;
+        *pos2++ = tmp;
+    }
+}
+
+
+/* sort two objects */
+static inline void UTL_SortTwo(const UTL_SortInfo *sort, uint8_t *pos1, uint8_t *pos2) {
+    if (UTL_SortCmp(sort, pos2, pos1) < 0) UTL_SortSwap(sort, pos1, pos2);
+}
+
+
+/* sort three objects, the median ends up at @pos2 */
+static inline void UTL_SortThree(const UTL_SortInfo *sort, uint8_t *pos1, uint8_t *pos2, uint8_t *pos3) {
+    UTL_SortTwo(sort, pos1, pos2);
+    UTL_SortTwo(sort, pos2, pos3);
+    UTL_SortTwo(sort, pos1, pos2);
+}
+
+
+static void UTL_InsertionSort(const UTL_SortInfo *sort, uint8_t *data, int count) {
+    for (int i = 1; i < count; i++) {
+        if (UTL_SortCmp(sort, UTL_SortAt(sort, data, i), UTL_SortAt(sort, data, i-1)) >= 0) continue;
+
+        memcpy(sort->tmp, UTL_SortAt(sort, data, i), sort->size);
+        int j = i;
+        do {
+            memcpy(UTL_SortAt(sort, data, j), UTL_SortAt(sort, data, j-1), sort->size);
+            j--;
+        } while (j > 0 && UTL_SortCmp(sort, sort->tmp, UTL_SortAt(sort, data, j-1)) < 0);
+        memcpy(UTL_SortAt(sort, data, j), sort->tmp, sort->size);
+    }
+}
+
+
+/* insertion sort, that gives up after a few moves. returns true if the range got sorted */
+static bool UTL_PartialInsertionSort(const UTL_SortInfo *sort, uint8_t *data, int count) {
+    int moves = 0;
+
+    for (int i = 1; i < count; i++) {
+        if (UTL_SortCmp(sort, UTL_SortAt(sort, data, i), UTL_SortAt(sort, data, i-1)) >= 0) continue;
+
+        memcpy(sort->tmp, UTL_SortAt(sort, data, i), sort->size);
+        int j = i;
+        do {
+            memcpy(UTL_SortAt(sort, data, j), UTL_SortAt(sort, data, j-1), sort->size);
+            j--;
+        } while (j > 0 && UTL_SortCmp(sort, sort->tmp, UTL_SortAt(sort, data, j-1)) < 0);
+        memcpy(UTL_SortAt(sort, data, j), sort->tmp, sort->size);
+
+        moves += i - j;
+        if (moves > UTL_SORT_PARTIAL_INSERTION_LIMIT) return false;
+    }
+
+    return true;
+}
+
+
+static void UTL_HeapSiftDown(const UTL_SortInfo *sort, uint8_t *data, int root, int count) {
+    for (int child = 2 * root + 1; child < count; child = 2 * root + 1) {
+        if (child + 1 < count && UTL_SortCmp(sort, UTL_SortAt(sort, data, child), UTL_SortAt(sort, data, child+1)) < 0)
+            child++;
+        if (UTL_SortCmp(sort, UTL_SortAt(sort, data, root), UTL_SortAt(sort, data, child)) >= 0)
+            return;
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, root), UTL_SortAt(sort, data, child));
+        root = child;
+    }
+}
+
+
+static void UTL_HeapSort(const UTL_SortInfo *sort, uint8_t *data, int count) {
+    for (int i = count / 2 - 1; i >= 0; i--)
+        UTL_HeapSiftDown(sort, data, i, count);
+
+    for (int i = count - 1; i > 0; i--) {
+        UTL_SortSwap(sort, data, UTL_SortAt(sort, data, i));
+        UTL_HeapSiftDown(sort, data, 0, i);
+    }
+}
+
+
+/* partition around the pivot at data[0], objects equal to the pivot go to the right.
+ * returns the final position of the pivot, @alreadyPartitioned is set if no objects had to be swapped */
+static int UTL_PartitionRight(const UTL_SortInfo *sort, uint8_t *data, int count, bool *alreadyPartitioned) {
+    memcpy(sort->pivot, data, sort->size);
+
+    int first = 0;
+    int last  = count;
+
+    // median of three guarantees that these scans stop before running off the range
+    while (UTL_SortCmp(sort, UTL_SortAt(sort, data, ++first), sort->pivot) < 0);
+
+    if (first == 1) while (first < last && UTL_SortCmp(sort, UTL_SortAt(sort, data, --last), sort->pivot) >= 0);
+    else            while (UTL_SortCmp(sort, UTL_SortAt(sort, data, --last), sort->pivot) >= 0);
+
+    *alreadyPartitioned = first >= last;
+
+    while (first < last) {
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, first), UTL_SortAt(sort, data, last));
+        while (UTL_SortCmp(sort, UTL_SortAt(sort, data, ++first), sort->pivot) <  0);
+        while (UTL_SortCmp(sort, UTL_SortAt(sort, data, --last),  sort->pivot) >= 0);
+    }
+
+    int pivotPos = first - 1;
+    memcpy(data, UTL_SortAt(sort, data, pivotPos), sort->size);
+    memcpy(UTL_SortAt(sort, data, pivotPos), sort->pivot, sort->size);
+    return pivotPos;
+}
+
+
+/* partition around the pivot at data[0], objects equal to the pivot go to the left.
+ * used when the pivot equals the object left of the range, so the equal objects never need to be touched again */
+static int UTL_PartitionLeft(const UTL_SortInfo *sort, uint8_t *data, int count) {
+    memcpy(sort->pivot, data, sort->size);
+
+    int first = 0;
+    int last  = count;
+
+    while (UTL_SortCmp(sort, sort->pivot, UTL_SortAt(sort, data, --last)) < 0);
+
+    if (last + 1 == count) while (first < last && UTL_SortCmp(sort, sort->pivot, UTL_SortAt(sort, data, ++first)) >= 0);
+    else                   while (UTL_SortCmp(sort, sort->pivot, UTL_SortAt(sort, data, ++first)) >= 0);
+
+    while (first < last) {
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, first), UTL_SortAt(sort, data, last));
+        while (UTL_SortCmp(sort, sort->pivot, UTL_SortAt(sort, data, --last))  <  0);
+        while (UTL_SortCmp(sort, sort->pivot, UTL_SortAt(sort, data, ++first)) >= 0);
+    }
+
+    memcpy(data, UTL_SortAt(sort, data, last), sort->size);
+    memcpy(UTL_SortAt(sort, data, last), sort->pivot, sort->size);
+    return last;
+}
+
+
+/* break up patterns that caused an unbalanced partition by swapping a few objects around */
+static void UTL_SortShuffle(const UTL_SortInfo *sort, uint8_t *data, int count) {
+    if (count < UTL_SORT_INSERTION_THRESHOLD) return;
+
+    int quarter = count / 4;
+    UTL_SortSwap(sort, data, UTL_SortAt(sort, data, quarter));
+    UTL_SortSwap(sort, UTL_SortAt(sort, data, count - 1), UTL_SortAt(sort, data, count - quarter));
+
+    if (count > UTL_SORT_NINTHER_THRESHOLD) {
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, 1), UTL_SortAt(sort, data, quarter + 1));
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, 2), UTL_SortAt(sort, data, quarter + 2));
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, count - 2), UTL_SortAt(sort, data, count - (quarter + 1)));
+        UTL_SortSwap(sort, UTL_SortAt(sort, data, count - 3), UTL_SortAt(sort, data, count - (quarter + 2)));
+    }
+}
+
+
+/* pattern-defeating quicksort (introsort with pattern detection) */
+static void UTL_PdqSort(const UTL_SortInfo *sort, uint8_t *data, int count, int badAllowed, bool leftmost) {
+    while (true) {
+        if (count < UTL_SORT_INSERTION_THRESHOLD) {
+            UTL_InsertionSort(sort, data, count);
+            return;
+        }
+
+        // choose pivot and move it to data[0]
+        int half = count / 2;
+        if (count > UTL_SORT_NINTHER_THRESHOLD) {
+            UTL_SortThree(sort, data, UTL_SortAt(sort, data, half), UTL_SortAt(sort, data, count - 1));
+            UTL_SortThree(sort, UTL_SortAt(sort, data, 1), UTL_SortAt(sort, data, half - 1), UTL_SortAt(sort, data, count - 2));
+            UTL_SortThree(sort, UTL_SortAt(sort, data, 2), UTL_SortAt(sort, data, half + 1), UTL_SortAt(sort, data, count - 3));
+            UTL_SortThree(sort, UTL_SortAt(sort, data, half - 1), UTL_SortAt(sort, data, half), UTL_SortAt(sort, data, half + 1));
+            UTL_SortSwap(sort, data, UTL_SortAt(sort, data, half));
+        }
+        else {
+            UTL_SortThree(sort, UTL_SortAt(sort, data, half), data, UTL_SortAt(sort, data, count - 1));
+        }
+
+        // many objects equal to the pivot: put them all to the left and skip them
+        if (!leftmost && UTL_SortCmp(sort, data - sort->size, data) >= 0) {
+            int pivotPos = UTL_PartitionLeft(sort, data, count);
+            data   = UTL_SortAt(sort, data, pivotPos + 1);
+            count -= pivotPos + 1;
+            continue;
+        }
+
+        bool alreadyPartitioned;
+        int pivotPos   = UTL_PartitionRight(sort, data, count, &alreadyPartitioned);
+        int leftCount  = pivotPos;
+        int rightCount = count - pivotPos - 1;
+
+        if (leftCount < count / 8 || rightCount < count / 8) {
+            // too many bad partitions -> guarantee O(n log n) with heap sort
+            if (--badAllowed == 0) {
+                UTL_HeapSort(sort, data, count);
+                return;
+            }
+            UTL_SortShuffle(sort, data, leftCount);
+            UTL_SortShuffle(sort, UTL_SortAt(sort, data, pivotPos + 1), rightCount);
+        }
+        else if (alreadyPartitioned
+              && UTL_PartialInsertionSort(sort, data, leftCount)
+              && UTL_PartialInsertionSort(sort, UTL_SortAt(sort, data, pivotPos + 1), rightCount)) {
+            return; // input was (almost) sorted already
+        }
+
+        UTL_PdqSort(sort, data, leftCount, badAllowed, leftmost);
+        data     = UTL_SortAt(sort, data, pivotPos + 1);
+        count    = rightCount;
+        leftmost = false;
+    }
+}
+
+
+/* merge sorted ranges @left and @right into @dst. takes from @left on ties, so merging is stable */
+static void UTL_SortMerge(const UTL_SortInfo *sort, uint8_t *dst, const uint8_t *left, int leftCount, const uint8_t *right, int rightCount) {
+    const uint8_t *leftEnd  = UTL_SortAt(sort, left,  leftCount);
+    const uint8_t *rightEnd = UTL_SortAt(sort, right, rightCount);
+
+    while (left < leftEnd && right < rightEnd) {
+        if (UTL_SortCmp(sort, right, left) < 0) {
+            memcpy(dst, right, sort->size);
+            right += sort->size;
+        }
+        else {
+            memcpy(dst, left, sort->size);
+            left += sort->size;
+        }
+        dst += sort->size;
+    }
+
+    memcpy(dst, left, leftEnd - left);
+    dst += leftEnd - left;
+    memcpy(dst, right, rightEnd - right);
+}
+
+
+/* bottom up merge sort, sorts runs with insertion sort and then merges them back and forth between @data and @buffer */
+static void UTL_MergeSort(const UTL_SortInfo *sort, uint8_t *data, uint8_t *buffer, int count) {
+    for (int first = 0; first < count; first += UTL_SORT_STABLE_RUN_LENGTH) {
+        int runLength = count - first < UTL_SORT_STABLE_RUN_LENGTH ? count - first : UTL_SORT_STABLE_RUN_LENGTH;
+        UTL_InsertionSort(sort, UTL_SortAt(sort, data, first), runLength);
+    }
+
+    uint8_t *src = data;
+    uint8_t *dst = buffer;
+
+    for (int width = UTL_SORT_STABLE_RUN_LENGTH; width < count; width *= 2) {
+        for (int first = 0; first < count; first += 2 * width) {
+            int leftCount  = count - first < width ? count - first : width;
+            int rightCount = count - first - leftCount < width ? count - first - leftCount : width;
+            UTL_SortMerge(sort, UTL_SortAt(sort, dst, first),
+                          UTL_SortAt(sort, src, first), leftCount,
+                          UTL_SortAt(sort, src, first + leftCount), rightCount);
+        }
+        uint8_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != data) memcpy(data, src, (size_t)count * sort->size);
+}
+
+
+/* key for radix sorting ints: flip the sign bit, so negative numbers come first */
+static inline uint32_t UTL_RadixKeyInt(uint32_t bits) {
+    return bits ^ 0x80000000u;
+}
+
+
+/* key for radix sorting floats: flip all bits of negative numbers, only the sign bit of positive ones */
+static inline uint32_t UTL_RadixKeyFloat(uint32_t bits) {
+    if (bits == 0x80000000u) bits = 0; // -0.0 compares equal to 0.0
+    return bits ^ ((uint32_t)(-(int32_t)(bits >> 31)) | 0x80000000u);
+}
+
+
+/* LSD radix sort of 32 bit ints or floats, one byte per pass. stable */
+static void UTL_RadixSort32(uint32_t *data, uint32_t *buffer, int count, bool isFloat) {
+    static const int numPasses = 4;
+    uint32_t (*histogram)[256] = calloc(numPasses, sizeof(*histogram));
+
+    for (int i = 0; i < count; i++) {
+        uint32_t key = isFloat ? UTL_RadixKeyFloat(data[i]) : UTL_RadixKeyInt(data[i]);
+        for (int pass = 0; pass < numPasses; pass++)
+            histogram[pass][(key >> (8 * pass)) & 0xFF]++;
+    }
+
+    uint32_t *src = data;
+    uint32_t *dst = buffer;
+
+    for (int pass = 0; pass < numPasses; pass++) {
+        int shift = 8 * pass;
+
+        // all keys share this digit -> nothing to do in this pass
+        uint32_t firstKey = isFloat ? UTL_RadixKeyFloat(src[0]) : UTL_RadixKeyInt(src[0]);
+        if (histogram[pass][(firstKey >> shift) & 0xFF] == (uint32_t) count) continue;
+
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            uint32_t digitCount = histogram[pass][digit];
+            histogram[pass][digit] = offset;
+            offset += digitCount;
+        }
+
+        for (int i = 0; i < count; i++) {
+            uint32_t key = isFloat ? UTL_RadixKeyFloat(src[i]) : UTL_RadixKeyInt(src[i]);
+            dst[histogram[pass][(key >> shift) & 0xFF]++] = src[i];
+        }
+
+        uint32_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != data) memcpy(data, src, sizeof(uint32_t) * count);
+    free(histogram);
+}
+
+
+/* counting sort for chars */
+static void UTL_CountingSortChar(char *data, int count) {
+    int histogram[256] = { 0 };
+    const unsigned bias = CHAR_MIN < 0 ? 0x80 : 0; // order of signed chars
+
+    for (int i = 0; i < count; i++)
+        histogram[(unsigned char)data[i] ^ bias]++;
+
+    for (int key = 0; key < 256; key++) {
+        memset(data, (int)(key ^ bias), histogram[key]);
+        data += histogram[key];
+    }
+}
+
+
+/* sort @count raw objects as stored in a list.
+ * dispatches to radix/counting sort for int, float and char stored by value, pdqsort or merge sort otherwise */
+static void UTL_SortData(const UTL_TypeInfo *dataType, bool byRef, uint8_t *data, int count, bool stable) {
+    if (count < 2) return;
+
+    if (!byRef && count >= UTL_SORT_RADIX_THRESHOLD) {
+        if (dataType == &UTL_TypeInfoChar) {
+            UTL_CountingSortChar((char*) data, count);
+            return;
+        }
+        if (dataType == &UTL_TypeInfoInt || dataType == &UTL_TypeInfoFloat) {
+            _STATIC_ASSERT(sizeof(int) == sizeof(uint32_t) && sizeof(float) == sizeof(uint32_t));
+            uint32_t *buffer = malloc(sizeof(uint32_t) * count);
+            UTL_RadixSort32((uint32_t*) data, buffer, count, dataType == &UTL_TypeInfoFloat);
+            free(buffer);
+            return;
+        }
+    }
+
+    UTL_SortScratch scratch[2];
+    UTL_SortInfo sort = {
+        .size  = byRef ? sizeof(void*) : dataType->size,
+        .cmp   = dataType->cmpFunc,
+        .byRef = byRef,
+        .tmp   = scratch[0].bytes,
+        .pivot = scratch[1].bytes
+    };
+
+    if (sort.size > sizeof(UTL_SortScratch)) {
+        sort.tmp   = malloc(2 * sort.size);
+        sort.pivot = sort.tmp + sort.size;
+    }
+
+    if (stable) {
+        uint8_t *buffer = malloc(sort.size * count);
+        UTL_MergeSort(&sort, data, buffer, count);
+        free(buffer);
+    }
+    else {
+        int badAllowed = 0;
+        for (int n = count; n > 1; n >>= 1) badAllowed++;
+        UTL_PdqSort(&sort, data, count, badAllowed, true);
+    }
+
+    if (sort.tmp != scratch[0].bytes) free(sort.tmp);
+}
+
+
+static void UTL_ArrayListSort(UTL_ArrayList *list, bool stable) {
+    UTL_SortData(list->dataType, list->byRef, list->data, list->count, stable);
+}
+
+
+/* bottom up merge sort on the nodes, relinks nodes instead of moving objects. stable */
+static void UTL_LinkedListSort(UTL_LinkedList *list) {
+    if (list->count < 2) return;
+
+    UTL_SortInfo sort = { .cmp = list->dataType->cmpFunc, .byRef = list->byRef };
+
+    // merge on the forward links only, with a null terminated chain
+    UTL_LinkedListNode *head = list->sentinel.next;
+    list->sentinel.prev->next = NULL;
+
+    for (int width = 1; ; width *= 2) {
+        UTL_LinkedListNode *left = head;
+        UTL_LinkedListNode *tail = NULL;
+        int numMerges = 0;
+        head = NULL;
+
+        while (left) {
+            numMerges++;
+
+            UTL_LinkedListNode *right = left;
+            int leftCount = 0;
+            while (right && leftCount < width) {
+                right = right->next;
+                leftCount++;
+            }
+            int rightCount = width;
+
+            while (leftCount > 0 || (rightCount > 0 && right)) {
+                UTL_LinkedListNode *node;
+
+                if (leftCount == 0) {
+                    node = right; right = right->next; rightCount--;
+                }
+                else if (rightCount == 0 || !right) {
+                    node = left; left = left->next; leftCount--;
+                }
+                else if (UTL_SortCmp(&sort, right->obj, left->obj) < 0) {
+                    node = right; right = right->next; rightCount--;
+                }
+                else {
+                    node = left; left = left->next; leftCount--;
+                }
+
+                if (tail) tail->next = node;
+                else      head = node;
+                tail = node;
+            }
+
+            left = right;
+        }
+
+        tail->next = NULL;
+        if (numMerges <= 1) break;
+    }
+
+    // restore backward links and close the ring at the sentinel
+    UTL_LinkedListNode *prev = &list->sentinel;
+    for (UTL_LinkedListNode *node = head; node; node = node->next) {
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
+    }
+    prev->next = &list->sentinel;
+    list->sentinel.prev = prev;
+}
+
+
+/* move the objects of a deque to the beginning of its buffer if they wrap around, then sort them in place */
+static void UTL_DequeListSort(UTL_DequeList *list, bool stable) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    if (list->head + list->count > list->capacity)
+        UTL_DequeListSetCapacity(list, list->capacity);
+
+    UTL_SortData(list->dataType, list->byRef, list->data + dataSize * list->head, list->count, stable);
+}
+
+
+/* gather the objects of all leaves into one array, sort it and scatter them back */
+static void UTL_TreeListSort(UTL_TreeList *list, bool stable) {
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *data = malloc(dataSize * list->count);
+
+    uint8_t *pos = data;
+    for (UTL_TreeListLeaf *leaf = list->head; leaf; leaf = leaf->next) {
+        memcpy(pos, leaf->data, dataSize * leaf->node.size);
+        pos += dataSize * leaf->node.size;
+    }
+
+    UTL_SortData(list->dataType, list->byRef, data, list->count, stable);
+
+    pos = data;
+    for (UTL_TreeListLeaf *leaf = list->head; leaf; leaf = leaf->next) {
+        memcpy(leaf->data, pos, dataSize * leaf->node.size);
+        pos += dataSize * leaf->node.size;
+    }
+
+    free(data);
+}
+
+
+/* gather the objects of all chunks into one array, sort it and scatter them back */
+static void UTL_UnrolledListSort(UTL_UnrolledList *list, bool stable) {
+    size_t dataSize = UTL_ListDataSize(list);
+    uint8_t *data = malloc(dataSize * list->count);
+
+    uint8_t *pos = data;
+    for (UTL_UnrolledListChunk *chunk = list->head; chunk; chunk = chunk->next) {
+        memcpy(pos, chunk->data, dataSize * chunk->count);
+        pos += dataSize * chunk->count;
+    }
+
+    UTL_SortData(list->dataType, list->byRef, data, list->count, stable);
+
+    pos = data;
+    for (UTL_UnrolledListChunk *chunk = list->head; chunk; chunk = chunk->next) {
+        memcpy(chunk->data, pos, dataSize * chunk->count);
+        pos += dataSize * chunk->count;
+    }
+
+    free(data);
+}
+
+
+// parallel sorting ///////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* lists smaller than this are not worth sorting in parallel */
+#define UTL_SORT_PARALLEL_THRESHOLD (1 << 16)
+
+
+typedef struct {
+    void (*func)(void*, int);  // function to run on each thread: func(aux, threadIndex)
+    void  *aux;                // passed to @func
+    int    threadIndex;        // passed to @func
+} UTL_ThreadTask;
+
+
+static void* UTL_ThreadMain(void *arg) {
+    UTL_ThreadTask *task = (UTL_ThreadTask*) arg;
+    task->func(task->aux, task->threadIndex);
+    return NULL;
+}
+
+
+/* run func(aux, i) for i in [0, numThreads) on @numThreads threads (one of them being the calling thread)
+ * and wait for all of them to finish */
+static void UTL_RunParallel(int numThreads, void (*func)(void*, int), void *aux) {
+    pthread_t      *threads = malloc(sizeof(pthread_t) * numThreads);
+    UTL_ThreadTask *tasks   = malloc(sizeof(UTL_ThreadTask) * numThreads);
+    bool           *started = malloc(sizeof(bool) * numThreads);
+
+    for (int i = 0; i < numThreads; i++)
+        tasks[i] = (UTL_ThreadTask) { .func = func, .aux = aux, .threadIndex = i };
+
+    for (int i = 1; i < numThreads; i++)
+        started[i] = pthread_create(&threads[i], NULL, &UTL_ThreadMain, &tasks[i]) == 0;
+
+    func(aux, 0);
+
+    // threads that could not be created are run here instead
+    for (int i = 1; i < numThreads; i++) {
+        if (started[i]) pthread_join(threads[i], NULL);
+        else            func(aux, i);
+    }
+
+    free(threads);
+    free(tasks);
+    free(started);
+}
+
+
+/** state shared by all threads of a parallel sort */
+typedef struct {
+    const UTL_TypeInfo *dataType;   // type of the sorted objects
+    UTL_SortInfo        sort;       // compare info for merging
+    int                 count;      // number of objects
+    int                 numThreads; // number of threads working on the sort
+    uint8_t            *src;        // sorted runs are read from here
+    uint8_t            *dst;        // and merged into here
+    int                *runs;       // first index of every run, plus @count
+    int                 numRuns;    // number of sorted runs in @src
+} UTL_ParallelSort;
+
+
+static void UTL_ParallelSortRun(void *aux, int threadIndex) {
+    UTL_ParallelSort *ps = (UTL_ParallelSort*) aux;
+
+    int first = ps->runs[threadIndex];
+    int count = ps->runs[threadIndex + 1] - first;
+    UTL_SortData(ps->dataType, ps->sort.byRef, UTL_SortAt(&ps->sort, ps->src, first), count, false);
+}
+
+
+/* number of objects taken from @left, when the first @k objects of the stable merge of @left and @right are produced */
+static int UTL_MergeCoRank(const UTL_SortInfo *sort, const uint8_t *left, int leftCount, const uint8_t *right, int rightCount, int k) {
+    int lo = k > rightCount ? k - rightCount : 0;
+    int hi = k < leftCount  ? k : leftCount;
+
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        int j = k - i;
+        // left[i] is not greater than right[j-1], so it belongs to the first k objects
+        if (j > 0 && UTL_SortCmp(sort, UTL_SortAt(sort, right, j - 1), UTL_SortAt(sort, left, i)) >= 0) lo = i + 1;
+        else                                                                                                hi = i;
+    }
+
+    return lo;
+}
+
+
+/* every thread produces an equally sized slice of the output, merging pairs of runs from @src into @dst */
+static void UTL_ParallelSortMerge(void *aux, int threadIndex) {
+    UTL_ParallelSort *ps   = (UTL_ParallelSort*) aux;
+    const UTL_SortInfo *sort = &ps->sort;
+
+    int sliceFirst = (int)((long long) ps->count * threadIndex       / ps->numThreads);
+    int sliceLast  = (int)((long long) ps->count * (threadIndex + 1) / ps->numThreads);
+
+    for (int r = 0; r < ps->numRuns; r += 2) {
+        int pairFirst = ps->runs[r];
+        int pairLast  = ps->runs[r + 2 <= ps->numRuns ? r + 2 : r + 1];
+        if (pairLast <= sliceFirst || pairFirst >= sliceLast) continue;
+
+        const uint8_t *left  = UTL_SortAt(sort, ps->src, pairFirst);
+        int leftCount        = ps->runs[r + 1] - pairFirst;
+        const uint8_t *right = UTL_SortAt(sort, ps->src, ps->runs[r + 1]);
+        int rightCount       = pairLast - ps->runs[r + 1];
+
+        int k0 = (sliceFirst > pairFirst ? sliceFirst : pairFirst) - pairFirst;
+        int k1 = (sliceLast  < pairLast  ? sliceLast  : pairLast)  - pairFirst;
+        int i0 = UTL_MergeCoRank(sort, left, leftCount, right, rightCount, k0);
+        int i1 = UTL_MergeCoRank(sort, left, leftCount, right, rightCount, k1);
+
+        UTL_SortMerge(sort, UTL_SortAt(sort, ps->dst, pairFirst + k0),
+                      UTL_SortAt(sort, left, i0), i1 - i0,
+                      UTL_SortAt(sort, right, k0 - i0), (k1 - i1) - (k0 - i0));
+    }
+}
+
+
+/* sort runs on all threads, then merge pairs of runs in parallel until one run is left */
+static void UTL_ArrayListSortParallel(UTL_ArrayList *list, int numThreads) {
+    UTL_ParallelSort ps = {
+        .dataType   = list->dataType,
+        .sort       = { .size = UTL_ListDataSize(list), .cmp = list->dataType->cmpFunc, .byRef = list->byRef },
+        .count      = list->count,
+        .numThreads = numThreads,
+        .src        = list->data,
+        .dst        = malloc(UTL_ListDataSize(list) * list->count),
+        .runs       = malloc(sizeof(int) * (numThreads + 1)),
+        .numRuns    = numThreads
+    };
+
+    for (int i = 0; i <= numThreads; i++)
+        ps.runs[i] = (int)((long long) list->count * i / numThreads);
+
+    UTL_RunParallel(numThreads, &UTL_ParallelSortRun, &ps);
+
+    while (ps.numRuns > 1) {
+        UTL_RunParallel(numThreads, &UTL_ParallelSortMerge, &ps);
+
+        // every pair of runs is a single run now
+        int numRuns = 0;
+        for (int r = 0; r < ps.numRuns; r += 2)
+            ps.runs[numRuns++] = ps.runs[r];
+        ps.runs[numRuns] = ps.count;
+        ps.numRuns = numRuns;
+
+        uint8_t *tmp = ps.src;
+        ps.src = ps.dst;
+        ps.dst = tmp;
+    }
+
+    if (ps.src != list->data) {
+        memcpy(list->data, ps.src, UTL_ListDataSize(list) * list->count);
+        ps.dst = ps.src;
+    }
+
+    free(ps.dst);
+    free(ps.runs);
+}
+
+
+// parallel list operations ///////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* every thread of a parallel list operation gets at least this many objects, smaller lists use fewer threads */
+#define UTL_PARALLEL_MIN_OBJECTS_PER_THREAD 4096
+
+/* size of a cache line, the states of a parallel reduce each start on their own */
+#define UTL_PARALLEL_CACHE_LINE 64
+
+
+/** state shared by all threads of a parallel for each, map or reduce */
+typedef struct UTL_ParallelApply UTL_ParallelApply;
+struct UTL_ParallelApply {
+    UTL_List *list;        // the list whose objects are visited
+    int       numThreads;  // number of threads, each visiting an equally sized range of indices
+    UTL_Span *spans;       // spans of the list
+    int      *spanFirst;   // index of the first object of each span, plus the list's count
+    int       numSpans;    // number of spans
+
+    void (*visit)(UTL_ParallelApply *pa, int threadIndex, int index, void *obj);  // called for every object
+
+    void     *aux;                                     // passed to the callbacks below
+    void    (*forEachFunc)(void*, void*);              // parallel for each: forEachFunc(aux, obj)
+    void    (*mapFunc)(void*, void*, void*);           // parallel map: mapFunc(aux, dstObj, obj)
+    uint8_t  *dst;                                     // parallel map: where the mapped objects are stored
+    size_t    dstSize;                                 // parallel map: size of one stored mapped object
+    void    (*reduceFunc)(void*, void*, void*);        // parallel reduce: reduceFunc(aux, state, obj)
+    uint8_t  *states;                                  // parallel reduce: one state per thread
+    size_t    stateSize;                               // parallel reduce: size of one state
+    size_t    stateStride;                             // parallel reduce: distance between the states of two threads
+};
+
+
+static void UTL_ParallelVisitForEach(UTL_ParallelApply *pa, int threadIndex, int index, void *obj) {
+    (void) threadIndex;
+    (void) index;
+    pa->forEachFunc(pa->aux, obj);
+}
+
+
+static void UTL_ParallelVisitMap(UTL_ParallelApply *pa, int threadIndex, int index, void *obj) {
+    (void) threadIndex;
+    pa->mapFunc(pa->aux, pa->dst + pa->dstSize * index, obj);
+}
+
+
+static void UTL_ParallelVisitReduce(UTL_ParallelApply *pa, int threadIndex, int index, void *obj) {
+    (void) index;
+    pa->reduceFunc(pa->aux, pa->states + pa->stateStride * threadIndex, obj);
+}
+
+
+/* number of threads to use for a parallel operation on @list, all processors if @numThreads is not positive */
+static int UTL_ParallelNumThreads(UTL_List *list, int numThreads) {
+    if (numThreads <= 0) numThreads = UTL_NumProcessors();
+    if (numThreads > list->count / UTL_PARALLEL_MIN_OBJECTS_PER_THREAD) numThreads = list->count / UTL_PARALLEL_MIN_OBJECTS_PER_THREAD;
+    return numThreads > 1 ? numThreads : 1;
+}
+
+
+/* visit the objects of one thread's range of indices, span by span */
+static void UTL_ParallelApplyRun(void *aux, int threadIndex) {
+    UTL_ParallelApply *pa = (UTL_ParallelApply*) aux;
+
+    int first = (int)((long long) pa->list->count * threadIndex       / pa->numThreads);
+    int last  = (int)((long long) pa->list->count * (threadIndex + 1) / pa->numThreads);
+    if (first >= last) return;
+
+    // last span starting at or before @first
+    int lo = 0, hi = pa->numSpans - 1;
+    while (lo < hi) {
+        int mid = hi - (hi - lo) / 2;
+        if (pa->spanFirst[mid] <= first) lo = mid;
+        else                              hi = mid - 1;
+    }
+
+    for (int s = lo, index = first; index < last; s++) {
+        const UTL_Span *span = &pa->spans[s];
+        int end = pa->spanFirst[s + 1] < last ? pa->spanFirst[s + 1] : last;
+        uint8_t *pos = (uint8_t*) span->ptr + span->stride * (index - pa->spanFirst[s]);
+
+        for (; index < end; index++, pos += span->stride)
+            pa->visit(pa, threadIndex, index, UTL_ListPos2Obj(pa->list, pos));
+    }
+}
+
+
+/* visit all objects of the list on @pa->numThreads threads */
+static void UTL_ParallelApplyExec(UTL_ParallelApply *pa) {
+    UTL_List *list = pa->list;
+
+    if (pa->numThreads == 1) {
+        int index = 0;
+        for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter)) {
+            uint8_t *pos = iter.span.ptr;
+            for (int i = 0; i < iter.span.count; i++, index++, pos += iter.span.stride)
+                pa->visit(pa, 0, index, UTL_ListPos2Obj(list, pos));
+        }
+        return;
+    }
+
+    pa->numSpans  = UTL_ListGetSpans(list, NULL, 0);
+    pa->spans     = malloc(sizeof(UTL_Span) * pa->numSpans);
+    pa->spanFirst = malloc(sizeof(int) * (pa->numSpans + 1));
+    UTL_ListGetSpans(list, pa->spans, pa->numSpans);
+
+    pa->spanFirst[0] = 0;
+    for (int s = 0; s < pa->numSpans; s++)
+        pa->spanFirst[s + 1] = pa->spanFirst[s] + pa->spans[s].count;
+
+    UTL_RunParallel(pa->numThreads, &UTL_ParallelApplyRun, pa);
+
+    free(pa->spans);
+    free(pa->spanFirst);
+}
+
+
+// sorted lists ///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* binary searches over more objects than this prefetch both candidates for the next probe */
+#define UTL_BOUND_PREFETCH_THRESHOLD 1024
+
+
+/* the bound functions return the index of the first object not ordered before @obj (lower bound),
+ * or of the first object ordered after @obj (upper bound). they are branchless: every probe only moves
+ * the base of the range, the number of probes depends on the size of the range alone */
+
+static int UTL_BoundInBlock(UTL_List *list, const uint8_t *data, int n, void *obj, bool upper) {
+    if (n == 0) return 0;
+
+    UTL_CmpFunc *cmp = list->dataType->cmpFunc;
+    size_t size = UTL_ListDataSize(list);
+    int threshold = upper ? 1 : 0;
+    const uint8_t *base = data;
+
+    while (n > 1) {
+        int half = n / 2;
+        if (n > UTL_BOUND_PREFETCH_THRESHOLD) {
+            __builtin_prefetch(base + size * ((n - half) / 2));
+            __builtin_prefetch(base + size * (half + (n - half) / 2));
+        }
+        base = cmp(UTL_ListPos2Obj(list, base + size * half), obj) < threshold ? base + size * half : base;
+        n -= half;
+    }
+
+    return (int) ((base - data) / size) + (cmp(UTL_ListPos2Obj(list, base), obj) < threshold);
+}
+
+
+static int UTL_BoundInt(const int *data, int n, int value, bool upper) {
+    if (n == 0) return 0;
+
+    const int *base = data;
+    while (n > 1) {
+        int half = n / 2;
+        if (n > UTL_BOUND_PREFETCH_THRESHOLD) {
+            __builtin_prefetch(base + (n - half) / 2);
+            __builtin_prefetch(base + half + (n - half) / 2);
+        }
+        base = (base[half] < value) | (upper & (base[half] == value)) ? base + half : base;
+        n -= half;
+    }
+
+    return (int) (base - data) + ((*base < value) | (upper & (*base == value)));
+}
+
+
+/* ordered like UTL_TypeInfoFloat.cmpFunc, which reports unordered floats as equal */
+static int UTL_BoundFloat(const float *data, int n, float value, bool upper) {
+    if (n == 0) return 0;
+
+    const float *base = data;
+    while (n > 1) {
+        int half = n / 2;
+        if (n > UTL_BOUND_PREFETCH_THRESHOLD) {
+            __builtin_prefetch(base + (n - half) / 2);
+            __builtin_prefetch(base + half + (n - half) / 2);
+        }
+        base = (base[half] < value) | (upper & !(base[half] > value)) ? base + half : base;
+        n -= half;
+    }
+
+    return (int) (base - data) + ((*base < value) | (upper & !(*base > value)));
+}
+
+
+/* lower or upper bound of @obj in a sorted list, -1 if the list's data type has no compare function */
+static int UTL_ListBound(UTL_List *list, void *obj, bool upper) {
+    if (!list->dataType || !list->dataType->cmpFunc) return -1;
+
+    UTL_CmpFunc *cmp = list->dataType->cmpFunc;
+    int threshold = upper ? 1 : 0;
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST: {
+            uint8_t *data = ((UTL_ArrayList*) list)->data;
+            if (!list->byRef && list->dataType == &UTL_TypeInfoInt)
+                return UTL_BoundInt((int*) data, list->count, *(int*)obj, upper);
+            if (!list->byRef && list->dataType == &UTL_TypeInfoFloat)
+                return UTL_BoundFloat((float*) data, list->count, *(float*)obj, upper);
+            return UTL_BoundInBlock(list, data, list->count, obj, upper);
+        }
+        case UTL_UNROLLED_LIST: {
+            // skip whole chunks by their last object, then search the chunk containing the bound
+            UTL_UnrolledList *unrolled = (UTL_UnrolledList*) list;
+            int index = 0;
+            for (UTL_UnrolledListChunk *chunk = unrolled->head; chunk; chunk = chunk->next) {
+                void *last = UTL_ListPos2Obj(list, UTL_UnrolledListAt(list, chunk, chunk->count - 1));
+                if (cmp(last, obj) >= threshold)
+                    return index + UTL_BoundInBlock(list, chunk->data, chunk->count, obj, upper);
+                index += chunk->count;
+            }
+            return index;
+        }
+        case UTL_DEQUE_LIST:
+        case UTL_TREE_LIST: {
+            // indexed access is cheap, same halving as UTL_BoundInBlock()
+            int n = list->count, base = 0;
+            if (n == 0) return 0;
+
+            while (n > 1) {
+                int half = n / 2;
+                base = cmp(UTL_ListGet(list, base + half), obj) < threshold ? base + half : base;
+                n -= half;
+            }
+            return base + (cmp(UTL_ListGet(list, base), obj) < threshold);
+        }
+        default: {
+            UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+            while (UTL_ListIterIsValid(&iter)) {
+                if (cmp(UTL_ListIterGet(&iter), obj) >= threshold) return iter.index;
+                UTL_ListIterNext(&iter);
+            }
+            return list->count;
+        }
+    }
+}
+
+
+/* the next object of one of the lists being merged */
+typedef struct {
+    UTL_ListIter iter;  // position in its list
+    void        *obj;   // object at that position
+    int          list;  // index of its list, breaks ties so that merging is stable
+} UTL_MergeCursor;
+
+
+static inline bool UTL_MergeCursorLess(UTL_CmpFunc *cmp, const UTL_MergeCursor *c1, const UTL_MergeCursor *c2) {
+    int c = cmp(c1->obj, c2->obj);
+    return c < 0 || (c == 0 && c1->list < c2->list);
+}
+
+
+static void UTL_MergeSiftDown(UTL_CmpFunc *cmp, UTL_MergeCursor *heap, int root, int n) {
+    UTL_MergeCursor cursor = heap[root];
+    for (int child = 2 * root + 1; child < n; child = 2 * root + 1) {
+        if (child + 1 < n && UTL_MergeCursorLess(cmp, &heap[child + 1], &heap[child])) child++;
+        if (!UTL_MergeCursorLess(cmp, &heap[child], &cursor)) break;
+        heap[root] = heap[child];
+        root = child;
+    }
+    heap[root] = cursor;
+}
+
+
+// incremental operations /////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* maximum number of ranges waiting to be sorted, the smaller half of a range is always sorted first */
+#define UTL_SORT_INCREMENTAL_STACK_SIZE 64
+
+/* number of steps between two looks at the clock */
+#define UTL_INCREMENTAL_CLOCK_INTERVAL 64
+
+
+typedef enum {
+    UTL_INCREMENTAL_SORT,
+    UTL_INCREMENTAL_COMPACT
+} UTL_IncrementalKind;
+
+
+/* what the sort is doing with its current range */
+typedef enum {
+    UTL_SORT_STEP_NEXT_RANGE,  // take the next range from the stack
+    UTL_SORT_STEP_INSERTION,   // insertion sort by swapping neighbours, @i is the object to insert, @j its position
+    UTL_SORT_STEP_SCAN_I,      // partitioning, move @i right to an object not less than the pivot
+    UTL_SORT_STEP_SCAN_J,      // partitioning, move @j left to an object not greater than the pivot
+    UTL_SORT_STEP_HEAP,        // heap sort, sifting down @siftRoot or picking the next root to sift
+    UTL_SORT_STEP_DONE
+} UTL_SortStep;
+
+
+/* a range of objects waiting to be sorted */
+typedef struct {
+    int first;       // index of the first object
+    int last;        // index behind the last object
+    int badAllowed;  // depth left before falling back to heap sort
+} UTL_SortRange;
+
+
+/* state of an incremental sort, an introsort which stops after any comparison and keeps its position */
+typedef struct {
+    UTL_SortInfo    sort;       // compare info
+    UTL_SortScratch pivot;      // holds the pivot of small objects, larger ones get their own buffer
+    UTL_Span        span;       // the objects if they form a single span
+    uint8_t       **objs;       // position of every object otherwise, NULL for a single span
+    UTL_SortStep    step;       // see UTL_SortStep
+    UTL_SortRange   range;      // range currently being sorted
+    UTL_SortRange   stack[UTL_SORT_INCREMENTAL_STACK_SIZE];  // ranges waiting to be sorted
+    int             numRanges;  // number of ranges on the stack
+    int             i, j;       // cursors into the current range
+    int             siftRoot;   // heap sort: object being sifted down, -1 if none
+    int             heapEnd;    // heap sort: number of objects in the heap
+} UTL_SortIncremental;
+
+
+/* state of an incremental compaction, the nodes in front of @node were moved already */
+typedef struct {
+    UTL_ListNodeSlab   *slab;  // new slab holding the list of a private pool, NULL for a shared pool
+    uint8_t            *pos;   // next node to move an object to
+    uint8_t            *end;   // end of the nodes to move objects to
+    UTL_LinkedListNode *prev;  // last node moved, or the sentinel
+    UTL_LinkedListNode *node;  // next node to move
+} UTL_CompactIncremental;
+
+
+/* state of any incremental operation, referenced by UTL_ListIncremental.auxData */
+typedef struct {
+    UTL_IncrementalKind    kind;     // operation in progress
+    UTL_List              *list;     // list being worked on
+    UTL_SortIncremental    sort;     // state of a sort
+    UTL_CompactIncremental compact;  // state of a compaction
+} UTL_IncrementalState;
+
+
+/* stops a loop of incremental steps when the step count or time budget is used up */
+typedef struct {
+    int       maxSteps;  // not positive for no limit
+    long long budgetNs;  // not positive for no limit
+    long long startNs;   // time of the first step
+    int       steps;     // steps done so far
+} UTL_IncrementalBudget;
+
+
+static UTL_IncrementalBudget UTL_IncrementalBudgetStart(int maxSteps, long long budgetNs) {
+    return (UTL_IncrementalBudget) {
+        .maxSteps = maxSteps,
+        .budgetNs = budgetNs,
+        .startNs  = budgetNs > 0 ? UTL_TimeNs() : 0,
+        .steps    = 0
+    };
+}
+
+
+/* may another step be done? the clock is only read every few steps */
+static bool UTL_IncrementalBudgetLeft(const UTL_IncrementalBudget *budget) {
+    if (budget->maxSteps > 0 && budget->steps >= budget->maxSteps) return false;
+    if (budget->budgetNs > 0 && budget->steps > 0 && budget->steps % UTL_INCREMENTAL_CLOCK_INTERVAL == 0 &&
+        UTL_TimeNs() - budget->startNs >= budget->budgetNs) return false;
+    return true;
+}
+
+
+#define UTL_SortIncrementalAt(inc, at) \
+    ((inc)->objs ? (inc)->objs[at] : (uint8_t*) (inc)->span.ptr + (size_t)(at) * (inc)->span.stride)
+
+
+/* start sorting a list, the position of every object is looked up once unless they form a single span */
+static void UTL_SortIncrementalInit(UTL_SortIncremental *inc, UTL_List *list) {
+    size_t dataSize = UTL_ListDataSize(list);
+
+    inc->sort = (UTL_SortInfo) {
+        .size  = dataSize,
+        .cmp   = list->dataType->cmpFunc,
+        .byRef = list->byRef,
+        .tmp   = NULL,
+        .pivot = dataSize > sizeof(UTL_SortScratch) ? malloc(dataSize) : inc->pivot.bytes
+    };
+
+    UTL_ListSpanIter iter = UTL_ListGetSpanIter(list);
+    inc->span = iter.span;
+    inc->objs = NULL;
+    if (iter.span.count < list->count) {
+        inc->objs = malloc(sizeof(uint8_t*) * list->count);
+        for (int at = 0; UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter))
+            for (int k = 0; k < iter.span.count; k++)
+                inc->objs[at++] = (uint8_t*) iter.span.ptr + (size_t) k * iter.span.stride;
+    }
+
+    int badAllowed = 0;
+    for (int n = list->count; n > 1; n >>= 1) badAllowed++;
+
+    inc->step      = UTL_SORT_STEP_NEXT_RANGE;
+    inc->stack[0]  = (UTL_SortRange) { .first = 0, .last = list->count, .badAllowed = 2 * badAllowed };
+    inc->numRanges = 1;
+    inc->siftRoot  = -1;
+}
+
+
+/* push the two halves of a partitioned range, the larger one first so the stack stays shallow */
+static void UTL_SortIncrementalSplit(UTL_SortIncremental *inc, int mid) {
+    UTL_SortRange left  = { .first = inc->range.first, .last = mid,             .badAllowed = inc->range.badAllowed - 1 };
+    UTL_SortRange right = { .first = mid,              .last = inc->range.last, .badAllowed = inc->range.badAllowed - 1 };
+
+    bool leftLarger = left.last - left.first > right.last - right.first;
+    inc->stack[inc->numRanges++] = leftLarger ? left : right;
+    inc->stack[inc->numRanges++] = leftLarger ? right : left;
+    inc->step = UTL_SORT_STEP_NEXT_RANGE;
+}
+
+
+/* one step of heap sort on the current range. the heap is built by sifting down every inner node from the back
+ * (@i counts them down), then the root is swapped behind the heap until it is empty */
+static void UTL_SortIncrementalHeapStep(UTL_SortIncremental *inc) {
+    const UTL_SortInfo *sort = &inc->sort;
+    int first = inc->range.first;
+
+    if (inc->siftRoot < 0) {
+        if (inc->i > 0) {
+            inc->siftRoot = --inc->i;
+        }
+        else if (inc->heapEnd > 1) {
+            inc->heapEnd--;
+            UTL_SortSwap(sort, UTL_SortIncrementalAt(inc, first), UTL_SortIncrementalAt(inc, first + inc->heapEnd));
+            inc->siftRoot = 0;
+        }
+        else {
+            inc->step = UTL_SORT_STEP_NEXT_RANGE;
+        }
+        return;
+    }
+
+    int child = 2 * inc->siftRoot + 1;
+    if (child >= inc->heapEnd) {
+        inc->siftRoot = -1;
+        return;
+    }
+
+    if (child + 1 < inc->heapEnd &&
+        UTL_SortCmp(sort, UTL_SortIncrementalAt(inc, first + child), UTL_SortIncrementalAt(inc, first + child + 1)) < 0)
+        child++;
+
+    uint8_t *root = UTL_SortIncrementalAt(inc, first + inc->siftRoot);
+    uint8_t *pos  = UTL_SortIncrementalAt(inc, first + child);
+    if (UTL_SortCmp(sort, root, pos) >= 0) {
+        inc->siftRoot = -1;
+        return;
+    }
+
+    UTL_SortSwap(sort, root, pos);
+    inc->siftRoot = child;
+}
+
+
+/* do one step of sorting, usually a single comparison */
+static void UTL_SortIncrementalStep(UTL_SortIncremental *inc) {
+    const UTL_SortInfo *sort = &inc->sort;
+
+    switch (inc->step) {
+        case UTL_SORT_STEP_NEXT_RANGE: {
+            if (inc->numRanges == 0) {
+                inc->step = UTL_SORT_STEP_DONE;
+                break;
+            }
+
+            inc->range = inc->stack[--inc->numRanges];
+            int first = inc->range.first, count = inc->range.last - first;
+
+            if (count <= UTL_SORT_INSERTION_THRESHOLD) {
+                inc->step = UTL_SORT_STEP_INSERTION;
+                inc->i = inc->j = first + 1;
+            }
+            else if (inc->range.badAllowed <= 0) {
+                inc->step     = UTL_SORT_STEP_HEAP;
+                inc->i        = count / 2;
+                inc->heapEnd  = count;
+                inc->siftRoot = -1;
+            }
+            else {
+                // the median of three goes to the front as pivot, the largest of them to the back, so that
+                // both scans of the partition stop at the ends of the range
+                uint8_t *front = UTL_SortIncrementalAt(inc, first);
+                uint8_t *back  = UTL_SortIncrementalAt(inc, inc->range.last - 1);
+                UTL_SortThree(sort, UTL_SortIncrementalAt(inc, first + count / 2), front, back);
+                memcpy(sort->pivot, front, sort->size);
+
+                inc->step = UTL_SORT_STEP_SCAN_I;
+                inc->i = first - 1;
+                inc->j = inc->range.last;
+            }
+            break;
+        }
+
+        case UTL_SORT_STEP_INSERTION: {
+            if (inc->i >= inc->range.last) {
+                inc->step = UTL_SORT_STEP_NEXT_RANGE;
+                break;
+            }
+
+            uint8_t *pos  = UTL_SortIncrementalAt(inc, inc->j);
+            uint8_t *prev = UTL_SortIncrementalAt(inc, inc->j - 1);
+            if (UTL_SortCmp(sort, pos, prev) < 0) {
+                UTL_SortSwap(sort, pos, prev);
+                if (--inc->j > inc->range.first) break;
+            }
+            inc->j = ++inc->i;
+            break;
+        }
+
+        case UTL_SORT_STEP_SCAN_I:
+            if (UTL_SortCmp(sort, UTL_SortIncrementalAt(inc, ++inc->i), sort->pivot) >= 0)
+                inc->step = UTL_SORT_STEP_SCAN_J;
+            break;
+
+        case UTL_SORT_STEP_SCAN_J:
+            if (UTL_SortCmp(sort, UTL_SortIncrementalAt(inc, --inc->j), sort->pivot) > 0)
+                break;
+
+            if (inc->i >= inc->j) {
+                UTL_SortIncrementalSplit(inc, inc->j + 1);
+                break;
+            }
+            UTL_SortSwap(sort, UTL_SortIncrementalAt(inc, inc->i), UTL_SortIncrementalAt(inc, inc->j));
+            inc->step = UTL_SORT_STEP_SCAN_I;
+            break;
+
+        case UTL_SORT_STEP_HEAP:
+            UTL_SortIncrementalHeapStep(inc);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/* start compacting a linked list with at least one object, see UTL_LinkedListCompact() */
+static void UTL_CompactIncrementalInit(UTL_CompactIncremental *inc, UTL_LinkedList *list) {
+    UTL_ListNodePool *pool = list->pool;
+
+    if (pool == &list->ownPool) {
+        // the new slab joins the pool right away, so the pool owns it if the compaction is cancelled
+        inc->slab = malloc(sizeof(UTL_ListNodeSlab) + pool->nodeSize * list->count);
+        inc->slab->numNodes = list->count;
+        inc->slab->next     = pool->slabs;
+        pool->slabs         = inc->slab;
+        inc->pos = inc->slab->nodes;
+    }
+    else {
+        inc->slab = NULL;
+        inc->pos  = UTL_ListNodePoolAllocRun(pool, list->count);
+    }
+
+    inc->end  = inc->pos + pool->nodeSize * list->count;
+    inc->prev = &list->sentinel;
+    inc->node = list->sentinel.next;
+}
+
+
+/* move the next object into its new node, the list stays linked in order. returns true when all objects were moved */
+static bool UTL_CompactIncrementalStep(UTL_CompactIncremental *inc, UTL_LinkedList *list) {
+    UTL_ListNodePool   *pool = list->pool;
+    UTL_LinkedListNode *node = inc->node;
+    UTL_LinkedListNode *copy = (UTL_LinkedListNode*) inc->pos;
+
+    memcpy(copy->obj, node->obj, UTL_ListDataSize(list));
+    copy->prev = inc->prev;
+    copy->next = node->next;
+    copy->prev->next = copy;
+    copy->next->prev = copy;
+    UTL_ListNodePoolFree(pool, node);
+
+    inc->prev = copy;
+    inc->node = copy->next;
+    inc->pos += pool->nodeSize;
+    if (inc->node != &list->sentinel) return false;
+
+    // the new slab holds all objects of a private pool, the old ones are freed with everything handed out from them
+    if (inc->slab) {
+        pool->slabs = inc->slab->next;
+        UTL_ListNodePoolFreeSlabs(pool);
+        inc->slab->next = NULL;
+        pool->slabs = inc->slab;
+    }
+    return true;
+}
+
+
+/* free the state of an incremental operation, nodes reserved by an unfinished compaction go back to the pool */
+static void UTL_IncrementalFree(UTL_ListIncremental *op) {
+    UTL_IncrementalState *state = op->auxData;
+    if (!state) return;
+
+    if (state->kind == UTL_INCREMENTAL_SORT) {
+        free(state->sort.objs);
+        if (state->sort.sort.pivot != state->sort.pivot.bytes) free(state->sort.sort.pivot);
+    }
+    else {
+        UTL_ListNodePool *pool = ((UTL_LinkedList*) state->list)->pool;
+        for (; state->compact.pos < state->compact.end; state->compact.pos += pool->nodeSize)
+            UTL_ListNodePoolFree(pool, (UTL_LinkedListNode*) state->compact.pos);
+    }
+
+    free(state);
+    op->auxData = NULL;
+}
+
+
+/* the state of an operation of the given kind on @list, NULL if a new one has to be started.
+ * a state left from another operation or another list is dropped */
+static UTL_IncrementalState* UTL_IncrementalResume(UTL_ListIncremental *op, UTL_List *list, UTL_IncrementalKind kind) {
+    UTL_IncrementalState *state = op->auxData;
+    if (state && state->kind == kind && state->list == list) return state;
+
+    UTL_IncrementalFree(op);
+    op->steps = 0;
+    return NULL;
+}
+
+
+// abstract list functions ////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** free the memory associated with the given list */
+void UTL_ListDestroy(UTL_List *list) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListDestroy((UTL_ArrayList*) list);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListDestroy((UTL_LinkedList*) list);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListDestroy((UTL_DequeList*) list);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListDestroy((UTL_UnrolledList*) list);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListDestroy((UTL_TreeList*) list);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** get object at given index from a list */
+void* UTL_ListGet(UTL_List *list, int at) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            return UTL_ArrayListGet((UTL_ArrayList*) list, at);
+        case UTL_LINKED_LIST:
+            return UTL_LinkedListGet((UTL_LinkedList*) list, at);
+        case UTL_DEQUE_LIST:
+            return UTL_DequeListGet((UTL_DequeList*) list, at);
+        case UTL_UNROLLED_LIST:
+            return UTL_UnrolledListGet((UTL_UnrolledList*) list, at);
+        case UTL_TREE_LIST:
+            return UTL_TreeListGet((UTL_TreeList*) list, at);
+        default:
+            return NULL;
+    }
+}
+
+/** get the last objet from a list */
+void* UTL_ListGetBack(UTL_List *list) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            return UTL_ArrayListGetBack((UTL_ArrayList*) list);
+        case UTL_LINKED_LIST:
+            return UTL_LinkedListGetBack((UTL_LinkedList*) list);
+        case UTL_DEQUE_LIST:
+            return UTL_DequeListGetBack((UTL_DequeList*) list);
+        case UTL_UNROLLED_LIST:
+            return UTL_UnrolledListGetBack((UTL_UnrolledList*) list);
+        case UTL_TREE_LIST:
+            return UTL_TreeListGetBack((UTL_TreeList*) list);
+        default:
+            return NULL;
+    }
+}
+
+
+/** get the first object from a list */
+void* UTL_ListGetFront(UTL_List *list) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            return UTL_ArrayListGetFront((UTL_ArrayList*) list);
+        case UTL_LINKED_LIST:
+            return UTL_LinkedListGetFront((UTL_LinkedList*) list);
+        case UTL_DEQUE_LIST:
+            return UTL_DequeListGetFront((UTL_DequeList*) list);
+        case UTL_UNROLLED_LIST:
+            return UTL_UnrolledListGetFront((UTL_UnrolledList*) list);
+        case UTL_TREE_LIST:
+            return UTL_TreeListGetFront((UTL_TreeList*) list);
+        default:
+            return NULL;
+    }
+}
+
+
+/** set object at given index in a list */
+void UTL_ListSet(UTL_List *list, int at, void *obj) {
+    UTL_ListIter iter = UTL_ListGetIteratorAt(list, at);
+    UTL_ListIterSet(&iter, obj);
+}
+
+
+/** append a new object to the back of the list */
+void UTL_ListPushBack(UTL_List *list, void *obj) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListPushBack((UTL_ArrayList*) list, obj);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListPushBack((UTL_LinkedList*) list, obj);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListPushBack((UTL_DequeList*) list, obj);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListPushBack((UTL_UnrolledList*) list, obj);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListPushBack((UTL_TreeList*) list, obj);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** prepend a new object to the front of the list */
+void UTL_ListPushFront(UTL_List *list, void *obj) {
+    switch (list->listType) {
+        case UTL_DEQUE_LIST:
+            UTL_DequeListPushFront((UTL_DequeList*) list, obj);
+            break;
+        default:
+            UTL_ListInsert(list, 0, obj);
+            break;
+    }
+}
+
+
+/** insert a new object at index @at, moving the objects from there on back by one */
+void UTL_ListInsert(UTL_List *list, int at, void *obj) {
+    // snap insert position to boundaries
+    if (at < 0) at = 0;
+    if (at > list->count) at = list->count;
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListInsert((UTL_ArrayList*) list, at, obj);
+            break;
+        case UTL_LINKED_LIST:
+            if (at == list->count) {
+                UTL_LinkedListPushBack((UTL_LinkedList*) list, obj);
+            }
+            else {
+                UTL_ListIter iter = UTL_ListGetIteratorAt(list, at);
+                UTL_LinkedListInsertBefore((UTL_LinkedList*) list, iter.auxData, obj);
+            }
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListInsert((UTL_DequeList*) list, at, obj);
+            break;
+        case UTL_UNROLLED_LIST:
+            if (at == list->count) {
+                UTL_UnrolledListPushBack((UTL_UnrolledList*) list, obj);
+            }
+            else {
+                UTL_ListIter iter = UTL_ListGetIteratorAt(list, at);
+                UTL_UnrolledListInsertAt((UTL_UnrolledList*) list, iter.auxData, &iter.auxIndex, obj);
+            }
+            break;
+        case UTL_TREE_LIST: {
+            int offset;
+            UTL_TreeListLeaf *leaf = UTL_TreeListLocate((UTL_TreeList*) list, at, &offset);
+            UTL_TreeListInsertAt((UTL_TreeList*) list, leaf, &offset, obj);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+
+/** remove the last object from a list */
+void UTL_ListPopBack(UTL_List *list) {
+    if (!list->count) return;
+    UTL_ListRemove(list, list->count-1);
+}
+
+
+/** remove the first object from a list */
+void UTL_ListPopFront(UTL_List *list) {
+    if (!list->count) return;
+    UTL_ListRemove(list, 0);
+}
+
+
+/** remove the object at index @at from the list */
+void UTL_ListRemove(UTL_List *list, int at) {
+    UTL_ListIter iter = UTL_ListGetIteratorAt(list, at);
+    UTL_ListIterRemove(&iter);
+}
+
+
+/** make room for at least @capacity objects, so that pushing up to that many objects does not reallocate.
+ *  only array and deque lists keep their objects in one buffer, other list types ignore this */
+void UTL_ListReserve(UTL_List *list, int capacity) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            if (capacity > ((UTL_ArrayList*) list)->capacity)
+                UTL_ArrayListSetCapacity((UTL_ArrayList*) list, capacity);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListGrow((UTL_DequeList*) list, capacity);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** release the unused capacity of array and deque lists */
+void UTL_ListShrinkToFit(UTL_List *list) {
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            if (list->count < ((UTL_ArrayList*) list)->capacity)
+                UTL_ArrayListSetCapacity((UTL_ArrayList*) list, list->count);
+            break;
+        case UTL_DEQUE_LIST: {
+            int capacity = list->count ? 1 : 0;
+            while (capacity < list->count) capacity *= 2;
+
+            if (capacity < ((UTL_DequeList*) list)->capacity)
+                UTL_DequeListSetCapacity((UTL_DequeList*) list, capacity);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+
+/** fraction of the links between neighbouring objects of a linked list that do not join adjacent nodes in memory.
+ *  0 for lists built by pushing to the back or compacted lists, close to 1 if the nodes are scattered.
+ *  0 for other list types */
+float UTL_ListFragmentation(UTL_List *list) {
+    if (list->listType != UTL_LINKED_LIST || list->count < 2) return 0.0f;
+
+    int numSpans = UTL_ListGetSpans(list, NULL, 0);
+    return (float) (numSpans - 1) / (list->count - 1);
+}
+
+
+/** move the nodes of a linked list into one block in list order, if its fragmentation is above @threshold.
+ *  a negative @threshold always compacts. returns true if the list was compacted, other list types are left alone */
+bool UTL_ListCompact(UTL_List *list, float threshold) {
+    if (list->listType != UTL_LINKED_LIST) return false;
+    if (threshold >= 0.0f && UTL_ListFragmentation(list) <= threshold) return false;
+
+    UTL_LinkedListCompact((UTL_LinkedList*) list);
+    return true;
+}
+
+
+/** compact a linked list like UTL_ListCompact() over several calls, moving up to @maxSteps nodes per call and
+ *  stopping after about @budgetNs nanoseconds. returns true once the list is compacted */
+bool UTL_ListCompactIncremental(UTL_List *list, UTL_ListIncremental *op, int maxSteps, long long budgetNs) {
+    UTL_IncrementalState *state = UTL_IncrementalResume(op, list, UTL_INCREMENTAL_COMPACT);
+
+    if (!state) {
+        if (list->listType != UTL_LINKED_LIST) return true;
+        if (list->count == 0) {
+            UTL_LinkedListCompact((UTL_LinkedList*) list);
+            return true;
+        }
+
+        state = malloc(sizeof(UTL_IncrementalState));
+        state->kind = UTL_INCREMENTAL_COMPACT;
+        state->list = list;
+        UTL_CompactIncrementalInit(&state->compact, (UTL_LinkedList*) list);
+        op->auxData = state;
+    }
+
+    UTL_IncrementalBudget budget = UTL_IncrementalBudgetStart(maxSteps, budgetNs);
+    bool done = false;
+    while (!done && UTL_IncrementalBudgetLeft(&budget)) {
+        done = UTL_CompactIncrementalStep(&state->compact, (UTL_LinkedList*) list);
+        budget.steps++;
+    }
+
+    op->steps += budget.steps;
+    if (done) UTL_IncrementalFree(op);
+    return done;
+}
+
+
+/** append @n objects to the back of the list.
+ *  @objs points to @n consecutive objects, or to @n consecutive object pointers for lists storing objects by reference */
+void UTL_ListPushBackN(UTL_List *list, const void *objs, int n) {
+    UTL_ListInsertRange(list, list->count, objs, n);
+}
+
+
+/** insert @n objects at index @at, moving the objects from there on back by @n.
+ *  see UTL_ListPushBackN() for the layout of @objs, which must not point into the list itself */
+void UTL_ListInsertRange(UTL_List *list, int at, const void *objs, int n) {
+    if (n <= 0) return;
+
+    // snap insert position to boundaries
+    if (at < 0) at = 0;
+    if (at > list->count) at = list->count;
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListInsertRange((UTL_ArrayList*) list, at, objs, n);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListInsertRange((UTL_LinkedList*) list, at, objs, n);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListInsertRange((UTL_DequeList*) list, at, objs, n);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListInsertRange((UTL_UnrolledList*) list, at, objs, n);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListInsertRange((UTL_TreeList*) list, at, objs, n);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** remove @n objects starting at index @at from the list. the range is clipped to the list */
+void UTL_ListRemoveRange(UTL_List *list, int at, int n) {
+    if (at < 0) {
+        n += at;
+        at = 0;
+    }
+    if (n > list->count - at) n = list->count - at;
+    if (n <= 0) return;
+    UTL_ListMakeWritable(list);
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListRemoveRange((UTL_ArrayList*) list, at, n);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListRemoveRange((UTL_LinkedList*) list, at, n);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListRemoveRange((UTL_DequeList*) list, at, n);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListRemoveRange((UTL_UnrolledList*) list, at, n);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListRemoveRange((UTL_TreeList*) list, at, n);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** remove all objects for which @predFunc(@aux, obj) returns true, in a single pass over the list.
+ *  the remaining objects keep their order. returns the number of removed objects */
+int UTL_ListRemoveIf(UTL_List *list, bool (*predFunc)(void*,void*), void *aux) {
+    UTL_ListFilter filter = { .list = list, .predFunc = predFunc, .aux = aux, .dropIf = true };
+    return UTL_ListApplyFilter(list, &filter);
+}
+
+
+/** keep only the objects for which @predFunc(@aux, obj) returns true, see UTL_ListRemoveIf() */
+int UTL_ListRetainIf(UTL_List *list, bool (*predFunc)(void*,void*), void *aux) {
+    UTL_ListFilter filter = { .list = list, .predFunc = predFunc, .aux = aux, .dropIf = false };
+    return UTL_ListApplyFilter(list, &filter);
+}
+
+
+/** reduce every run of adjacent objects comparing equal to its first object, using the compare function
+ *  of the list's data type. sort the list first to remove all duplicates. returns the number of removed objects */
+int UTL_ListUnique(UTL_List *list) {
+    if (!list->dataType || !list->dataType->cmpFunc) return 0;
+
+    UTL_ListFilter filter = { .list = list, .unique = true };
+    return UTL_ListApplyFilter(list, &filter);
+}
+
+
+/** append all objects of @other to the back of @list. appending a list to itself doubles it */
+void UTL_ListAppendList(UTL_List *list, UTL_List *other) {
+    if (other->count == 0) return;
+
+    if (list->byRef != other->byRef || UTL_ListDataSize(list) != UTL_ListDataSize(other)) {
+        // objects are stored differently -> push them one by one
+        UTL_ListReserve(list, list->count + other->count);
+        for (UTL_ListIter iter = UTL_ListGetIteratorFront(other); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter))
+            UTL_ListPushBack(list, UTL_ListIterGet(&iter));
+    }
+    else if (other->listType == UTL_ARRAY_LIST && other != list) {
+        UTL_ListInsertRange(list, list->count, ((UTL_ArrayList*) other)->data, other->count);
+    }
+    else {
+        uint8_t *data = UTL_ListGather(other);
+        UTL_ListInsertRange(list, list->count, data, other->count);
+        free(data);
+    }
+}
+
+
+/** find the first index of the given object, at or after @offset */
+int UTL_ListFindFirst(UTL_List *list, void *obj, int offset) {
+    if (offset < 0) offset = 0;
+    if (offset >= list->count) return -1;
+
+    // vectorized search for arrays of primitive types
+    if (list->listType == UTL_ARRAY_LIST && !list->byRef) {
+        void *data = ((UTL_ArrayList*) list)->data;
+
+        if (list->dataType == &UTL_TypeInfoInt)
+            return UTL_SearchInt(data, offset, list->count, *(int*)obj);
+        if (list->dataType == &UTL_TypeInfoFloat)
+            return UTL_SearchFloat(data, offset, list->count, *(float*)obj);
+        if (list->dataType == &UTL_TypeInfoChar)
+            return UTL_SearchChar(data, offset, list->count, *(char*)obj);
+    }
+
+    UTL_ListIter iter = UTL_ListGetIteratorAt(list, offset);
+    while (UTL_ListIterIsValid(&iter)) {
+        if (UTL_ListObjEquals(list, UTL_ListIterGet(&iter), obj)) return iter.index;
+        UTL_ListIterNext(&iter);
+    }
+
+    return -1;
+}
+
+
+/** find the last index of the given object, at or before @offset */
+int UTL_ListFindLast(UTL_List *list, void *obj, int offset) {
+    if (offset >= list->count) offset = list->count - 1;
+    if (offset < 0) return -1;
+
+    // vectorized search for arrays of primitive types
+    if (list->listType == UTL_ARRAY_LIST && !list->byRef) {
+        void *data = ((UTL_ArrayList*) list)->data;
+
+        if (list->dataType == &UTL_TypeInfoInt)
+            return UTL_SearchLastInt(data, 0, offset + 1, *(int*)obj);
+        if (list->dataType == &UTL_TypeInfoFloat)
+            return UTL_SearchLastFloat(data, 0, offset + 1, *(float*)obj);
+        if (list->dataType == &UTL_TypeInfoChar)
+            return UTL_SearchLastChar(data, 0, offset + 1, *(char*)obj);
+    }
+
+    UTL_ListIter iter = UTL_ListGetIteratorAt(list, offset);
+    while (UTL_ListIterIsValid(&iter)) {
+        if (UTL_ListObjEquals(list, UTL_ListIterGet(&iter), obj)) return iter.index;
+        UTL_ListIterPrev(&iter);
+    }
+
+    return -1;
+}
+
+
+/** */
+bool UTL_ListContains(UTL_List *list, void *obj) {
+    return UTL_ListFindFirst(list, obj, 0) >= 0;
+}
+
+
+/** sort a list */
+void UTL_ListSort(UTL_List *list) {
+    if (list->count < 2 || !list->dataType || !list->dataType->cmpFunc) return;
+    UTL_ListMakeWritable(list);
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListSort((UTL_ArrayList*) list, false);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListSort((UTL_LinkedList*) list);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListSort((UTL_DequeList*) list, false);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListSort((UTL_UnrolledList*) list, false);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListSort((UTL_TreeList*) list, false);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** sort a list, keeping objects that compare equal in their original order */
+void UTL_ListSortStable(UTL_List *list) {
+    if (list->count < 2 || !list->dataType || !list->dataType->cmpFunc) return;
+    UTL_ListMakeWritable(list);
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListSort((UTL_ArrayList*) list, true);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListSort((UTL_LinkedList*) list);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListSort((UTL_DequeList*) list, true);
+            break;
+        case UTL_UNROLLED_LIST:
+            UTL_UnrolledListSort((UTL_UnrolledList*) list, true);
+            break;
+        case UTL_TREE_LIST:
+            UTL_TreeListSort((UTL_TreeList*) list, true);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/** sort a list on @numThreads threads (all processors if @numThreads is not positive).
+ *  array lists are split into runs which are sorted and then merged in parallel,
+ *  small lists and other list types are sorted on the calling thread using UTL_ListSort() */
+void UTL_ListSortParallel(UTL_List *list, int numThreads) {
+    if (list->count < 2 || !list->dataType || !list->dataType->cmpFunc) return;
+    UTL_ListMakeWritable(list);
+
+    if (numThreads <= 0) numThreads = UTL_NumProcessors();
+    if (numThreads > list->count / UTL_SORT_INSERTION_THRESHOLD) numThreads = list->count / UTL_SORT_INSERTION_THRESHOLD;
+
+    if (list->listType != UTL_ARRAY_LIST || list->count < UTL_SORT_PARALLEL_THRESHOLD || numThreads < 2) {
+        UTL_ListSort(list);
+        return;
+    }
+
+    UTL_ArrayListSortParallel((UTL_ArrayList*) list, numThreads);
+}
+
+
+/** sort a list over several calls, doing up to @maxSteps steps of about one comparison per call and stopping after
+ *  about @budgetNs nanoseconds. returns true once the list is sorted */
+bool UTL_ListSortIncremental(UTL_List *list, UTL_ListIncremental *op, int maxSteps, long long budgetNs) {
+    UTL_IncrementalState *state = UTL_IncrementalResume(op, list, UTL_INCREMENTAL_SORT);
+
+    if (!state) {
+        if (list->count < 2 || !list->dataType || !list->dataType->cmpFunc) return true;
+        UTL_ListMakeWritable(list);
+
+        state = malloc(sizeof(UTL_IncrementalState));
+        state->kind = UTL_INCREMENTAL_SORT;
+        state->list = list;
+        UTL_SortIncrementalInit(&state->sort, list);
+        op->auxData = state;
+    }
+
+    UTL_IncrementalBudget budget = UTL_IncrementalBudgetStart(maxSteps, budgetNs);
+    while (state->sort.step != UTL_SORT_STEP_DONE && UTL_IncrementalBudgetLeft(&budget)) {
+        UTL_SortIncrementalStep(&state->sort);
+        budget.steps++;
+    }
+
+    op->steps += budget.steps;
+    if (state->sort.step != UTL_SORT_STEP_DONE) return false;
+
+    UTL_IncrementalFree(op);
+    return true;
+}
+
+
+/** stop an incremental operation before it completed, the list stays valid */
+void UTL_ListIncrementalCancel(UTL_ListIncremental *op) {
+    UTL_IncrementalFree(op);
+}
+
+
+/** sum of all objects of an int or float list, 0 for lists of other types.
+ *  lists storing objects by value are summed span by span with SIMD instructions, ints exactly and floats in single precision lanes */
+double UTL_ListSum(UTL_List *list) {
+    if (list->dataType != &UTL_TypeInfoInt && list->dataType != &UTL_TypeInfoFloat) return 0.0;
+
+    bool isInt = list->dataType == &UTL_TypeInfoInt;
+    int64_t intSum = 0;
+    double floatSum = 0.0;
+
+    if (list->byRef) {
+        for (UTL_ListIter iter = UTL_ListGetIteratorFront(list); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter)) {
+            if (isInt) intSum   += *(int*)UTL_ListIterGet(&iter);
+            else       floatSum += *(float*)UTL_ListIterGet(&iter);
+        }
+        return isInt ? (double) intSum : floatSum;
+    }
+
+    for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter)) {
+        const uint8_t *pos = iter.span.ptr;
+
+        if (iter.span.stride == list->dataType->size) {
+            if (isInt) intSum   += UTL_SumInt((const int*) pos, iter.span.count);
+            else       floatSum += UTL_SumFloat((const float*) pos, iter.span.count);
+        }
+        else {
+            for (int i = 0; i < iter.span.count; i++, pos += iter.span.stride) {
+                if (isInt) intSum   += *(const int*) pos;
+                else       floatSum += *(const float*) pos;
+            }
+        }
+    }
+
+    return isInt ? (double) intSum : floatSum;
+}
+
+
+/** sum of all objects of an int or float list like UTL_ListSum(), but floats are summed pairwise:
+ *  the rounding error grows with the logarithm of the list size instead of linearly */
+double UTL_ListSumPairwise(UTL_List *list) {
+    if (list->dataType != &UTL_TypeInfoFloat) return UTL_ListSum(list);
+
+    if (UTL_ListIsNumericArray(list))
+        return UTL_SumFloatPairwise((float*) ((UTL_ArrayList*) list)->data, list->count);
+
+    float *data = malloc(sizeof(float) * list->count);
+    int i = 0;
+    for (UTL_ListIter iter = UTL_ListGetIteratorFront(list); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter))
+        data[i++] = *(float*)UTL_ListIterGet(&iter);
+
+    double sum = UTL_SumFloatPairwise(data, list->count);
+    free(data);
+    return sum;
+}
+
+
+/** copy the smallest and the largest object of a list to @min and @max, either of which may be NULL.
+ *  objects are compared with the compare function of the list's data type, NaNs in float lists are skipped.
+ *  returns false without copying anything if the list is empty or its data type has no compare function */
+bool UTL_ListMinMax(UTL_List *list, void *min, void *max) {
+    if (list->count == 0 || !list->dataType || !list->dataType->cmpFunc) return false;
+
+    if (UTL_ListIsNumericArray(list)) {
+        void *data = ((UTL_ArrayList*) list)->data;
+
+        if (list->dataType == &UTL_TypeInfoInt) {
+            int lo, hi;
+            UTL_MinMaxInt(data, list->count, &lo, &hi);
+            if (min) *(int*)min = lo;
+            if (max) *(int*)max = hi;
+        }
+        else {
+            float lo, hi;
+            UTL_MinMaxFloat(data, list->count, &lo, &hi);
+            if (min) *(float*)min = lo;
+            if (max) *(float*)max = hi;
+        }
+        return true;
+    }
+
+    UTL_CmpFunc *cmpFunc = list->dataType->cmpFunc;
+    bool isFloat = list->dataType == &UTL_TypeInfoFloat;
+    void *lo = NULL;
+    void *hi = NULL;
+
+    for (UTL_ListIter iter = UTL_ListGetIteratorFront(list); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter)) {
+        void *obj = UTL_ListIterGet(&iter);
+        if (isFloat && isnan(*(float*)obj)) continue;
+
+        if (!lo || cmpFunc(obj, lo) < 0) lo = obj;
+        if (!hi || cmpFunc(obj, hi) > 0) hi = obj;
+    }
+
+    // nothing but NaNs
+    if (!lo) lo = hi = UTL_ListGetFront(list);
+
+    if (min) memcpy(min, lo, list->dataType->size);
+    if (max) memcpy(max, hi, list->dataType->size);
+    return true;
+}
+
+
+/** copy the smallest object of a list to @min, see UTL_ListMinMax() */
+bool UTL_ListMin(UTL_List *list, void *min) {
+    return UTL_ListMinMax(list, min, NULL);
+}
+
+
+/** copy the largest object of a list to @max, see UTL_ListMinMax() */
+bool UTL_ListMax(UTL_List *list, void *max) {
+    return UTL_ListMinMax(list, NULL, max);
+}
+
+
+/** dot product of two int or two float lists, over as many objects as the shorter list has.
+ *  returns 0 for lists of other or different types */
+double UTL_ListDot(UTL_List *list1, UTL_List *list2) {
+    if (list1->dataType != list2->dataType) return 0.0;
+
+    bool isInt = list1->dataType == &UTL_TypeInfoInt;
+    if (!isInt && list1->dataType != &UTL_TypeInfoFloat) return 0.0;
+
+    int count = list1->count < list2->count ? list1->count : list2->count;
+
+    if (UTL_ListIsNumericArray(list1) && UTL_ListIsNumericArray(list2)) {
+        void *data1 = ((UTL_ArrayList*) list1)->data;
+        void *data2 = ((UTL_ArrayList*) list2)->data;
+
+        if (isInt) return (double) UTL_DotInt(data1, data2, count);
+        else       return UTL_DotFloat(data1, data2, count);
+    }
+
+    double dot = 0.0;
+    UTL_ListIter iter1 = UTL_ListGetIteratorFront(list1);
+    UTL_ListIter iter2 = UTL_ListGetIteratorFront(list2);
+    for (int i = 0; i < count; i++) {
+        if (isInt) dot += (double) *(int*)UTL_ListIterGet(&iter1)   * *(int*)UTL_ListIterGet(&iter2);
+        else       dot += (double) *(float*)UTL_ListIterGet(&iter1) * *(float*)UTL_ListIterGet(&iter2);
+        UTL_ListIterNext(&iter1);
+        UTL_ListIterNext(&iter2);
+    }
+    return dot;
+}
+
+
+/** multiply every object of an int or float list by @factor, ints are truncated toward zero and become INT_MIN
+ *  if the product is out of the range of int or NaN. lists of other types are left alone */
+void UTL_ListScale(UTL_List *list, double factor) {
+    if (list->count == 0 || (list->dataType != &UTL_TypeInfoInt && list->dataType != &UTL_TypeInfoFloat)) return;
+    UTL_ListMakeWritable(list);
+
+    if (UTL_ListIsNumericArray(list)) {
+        void *data = ((UTL_ArrayList*) list)->data;
+
+        if (list->dataType == &UTL_TypeInfoInt) UTL_ScaleInt(data, list->count, factor);
+        else                                    UTL_ScaleFloat(data, list->count, (float) factor);
+        return;
+    }
+
+    bool isInt = list->dataType == &UTL_TypeInfoInt;
+    for (UTL_ListIter iter = UTL_ListGetIteratorFront(list); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter)) {
+        if (isInt) *(int*)UTL_ListIterGet(&iter)   = UTL_ScaleIntValue(*(int*)UTL_ListIterGet(&iter), factor);
+        else       *(float*)UTL_ListIterGet(&iter) *= (float) factor;
+    }
+}
+
+
+/** return true if the given list is sorted */
+bool UTL_ListIsSorted(UTL_List *list) {
+    if (list->count < 2) return true;
+    if (!list->dataType || !list->dataType->cmpFunc) return false;
+
+    UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+    void *prev = UTL_ListIterGet(&iter);
+    UTL_ListIterNext(&iter);
+
+    while (UTL_ListIterIsValid(&iter)) {
+        void *obj = UTL_ListIterGet(&iter);
+        if (list->dataType->cmpFunc(obj, prev) < 0) return false;
+        prev = obj;
+        UTL_ListIterNext(&iter);
+    }
+
+    return true;
+}
+
+
+/** index of the first object of a sorted list that is not ordered before @obj, or the list's count if there is none.
+ *  returns -1 if the list's data type has no compare function */
+int UTL_ListLowerBound(UTL_List *list, void *obj) {
+    return UTL_ListBound(list, obj, false);
+}
+
+
+/** index of the first object of a sorted list that is ordered after @obj, see UTL_ListLowerBound() */
+int UTL_ListUpperBound(UTL_List *list, void *obj) {
+    return UTL_ListBound(list, obj, true);
+}
+
+
+/** index of the first object of a sorted list comparing equal to @obj, or -1 if there is none */
+int UTL_ListBinarySearch(UTL_List *list, void *obj) {
+    int at = UTL_ListBound(list, obj, false);
+    if (at < 0 || at >= list->count) return -1;
+    return list->dataType->cmpFunc(UTL_ListGet(list, at), obj) == 0 ? at : -1;
+}
+
+
+/** insert @obj into a sorted list behind all objects comparing equal to it, so the list stays sorted.
+ *  returns the index of the inserted object, or -1 without inserting if the list's data type has no compare function */
+int UTL_ListInsertSorted(UTL_List *list, void *obj) {
+    int at = UTL_ListBound(list, obj, true);
+    if (at >= 0) UTL_ListInsert(list, at, obj);
+    return at;
+}
+
+
+/** append the objects of two sorted lists to @dst in sorted order, see UTL_ListMergeSortedK() */
+void UTL_ListMergeSorted(UTL_List *dst, UTL_List *list1, UTL_List *list2) {
+    UTL_List *lists[2] = { list1, list2 };
+    UTL_ListMergeSortedK(dst, lists, 2);
+}
+
+
+/** append the objects of @numLists sorted lists to @dst in sorted order, using the compare function of @dst's
+ *  data type. objects comparing equal keep the order of their lists. @dst must not be one of the merged lists */
+void UTL_ListMergeSortedK(UTL_List *dst, UTL_List **lists, int numLists) {
+    if (!dst->dataType || !dst->dataType->cmpFunc) return;
+
+    int total = 0;
+    for (int i = 0; i < numLists; i++) total += lists[i]->count;
+    if (total == 0) return;
+
+    UTL_ListReserve(dst, dst->count + total);
+
+    // two arrays storing their objects like the destination array -> merge the raw data
+    if (numLists == 2 && dst->listType == UTL_ARRAY_LIST &&
+        lists[0]->listType == UTL_ARRAY_LIST && lists[0]->byRef == dst->byRef && UTL_ListDataSize(lists[0]) == UTL_ListDataSize(dst) &&
+        lists[1]->listType == UTL_ARRAY_LIST && lists[1]->byRef == dst->byRef && UTL_ListDataSize(lists[1]) == UTL_ListDataSize(dst)) {
+        UTL_ArrayList *array = (UTL_ArrayList*) dst;
+        UTL_SortInfo sort = { .size = UTL_ListDataSize(dst), .cmp = dst->dataType->cmpFunc, .byRef = dst->byRef };
+
+        UTL_SortMerge(&sort, UTL_SortAt(&sort, array->data, array->count),
+                      ((UTL_ArrayList*) lists[0])->data, lists[0]->count,
+                      ((UTL_ArrayList*) lists[1])->data, lists[1]->count);
+        array->count += total;
+        return;
+    }
+
+    // k-way merge through a min heap of the lists' next objects
+    UTL_CmpFunc *cmp = dst->dataType->cmpFunc;
+    UTL_MergeCursor *heap = malloc(sizeof(UTL_MergeCursor) * numLists);
+    int n = 0;
+
+    for (int i = 0; i < numLists; i++) {
+        if (lists[i]->count == 0) continue;
+        heap[n].iter = UTL_ListGetIteratorFront(lists[i]);
+        heap[n].obj  = UTL_ListIterGet(&heap[n].iter);
+        heap[n].list = i;
+        n++;
+    }
+
+    for (int i = n / 2 - 1; i >= 0; i--)
+        UTL_MergeSiftDown(cmp, heap, i, n);
+
+    while (n > 0) {
+        UTL_ListPushBack(dst, heap[0].obj);
+
+        UTL_ListIterNext(&heap[0].iter);
+        if (UTL_ListIterIsValid(&heap[0].iter)) heap[0].obj = UTL_ListIterGet(&heap[0].iter);
+        else                                    heap[0] = heap[--n];
+
+        UTL_MergeSiftDown(cmp, heap, 0, n);
+    }
+
+    free(heap);
+}
+
+
+void* UTL_ListFold(UTL_List *list, void* (*foldFunc)(void*,void*), void *state) {
+    UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+
+    while (UTL_ListIterIsValid(&iter)) {
+        state = foldFunc(state, UTL_ListIterGet(&iter));
+        UTL_ListIterNext(&iter);
+    }
+
+    return state;
 }
 
 
-/** */
-bool UTL_ListContains(UTL_List *list, void *obj) {
-    return UTL_ListFindFirst(list, obj, 0) >= 0;
+/** call forEachFunc(@aux, obj) for every object of the list on @numThreads threads (all processors if not positive).
+ *  the list is split into equally sized ranges of indices, lists too small to be worth it are visited on fewer threads */
+void UTL_ListParallelForEach(UTL_List *list, void (*forEachFunc)(void*,void*), void *aux, int numThreads) {
+    UTL_ListMakeWritable(list);
+
+    UTL_ParallelApply pa = {
+        .list        = list,
+        .numThreads  = UTL_ParallelNumThreads(list, numThreads),
+        .visit       = &UTL_ParallelVisitForEach,
+        .aux         = aux,
+        .forEachFunc = forEachFunc
+    };
+    UTL_ParallelApplyExec(&pa);
 }
 
 
-/** sort a list */
-void UTL_ListSort(UTL_List *list) {
-    (void) list;
-}
+/** append mapFunc(@aux, dstObj, obj) of every object of @src to @dst, computed on @numThreads threads.
+ *  @mapFunc stores its result at dstObj, see UTL_ListParallelForEach() */
+void UTL_ListParallelMap(UTL_List *dst, UTL_List *src, void (*mapFunc)(void*,void*,void*), void *aux, int numThreads) {
+    if (src->count == 0 || dst == src) return;
 
+    UTL_ParallelApply pa = {
+        .list       = src,
+        .numThreads = UTL_ParallelNumThreads(src, numThreads),
+        .visit      = &UTL_ParallelVisitMap,
+        .aux        = aux,
+        .mapFunc    = mapFunc,
+        .dstSize    = UTL_ListDataSize(dst)
+    };
 
-/** return true if the given list is sorted */
-bool UTL_ListIsSorted(UTL_List *list) {
-    (void) list;
-    return false;
+    if (dst->listType == UTL_ARRAY_LIST) {
+        // map right into the array's buffer
+        UTL_ArrayList *array = (UTL_ArrayList*) dst;
+        UTL_ListReserve(dst, dst->count + src->count);
+        pa.dst = array->data + pa.dstSize * array->count;
+        UTL_ParallelApplyExec(&pa);
+        array->count += src->count;
+    }
+    else {
+        pa.dst = malloc(pa.dstSize * src->count);
+        UTL_ParallelApplyExec(&pa);
+        UTL_ListInsertRange(dst, dst->count, pa.dst, src->count);
+        free(pa.dst);
+    }
 }
 
 
-void* UTL_ListFold(UTL_List *list, void* (*foldFunc)(void*,void*), void *state) {
-    UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+/** reduce all objects of the list into @result on @numThreads threads, see UTL_ListParallelForEach().
+ *  every thread starts with a copy of the @stateSize bytes at @result and calls reduceFunc(@aux, state, obj) for
+ *  the objects of its range, the states are then combined in list order with combineFunc(@aux, result, state) */
+void UTL_ListParallelReduce(UTL_List *list, void *result, size_t stateSize,
+                            void (*reduceFunc)(void*,void*,void*), void (*combineFunc)(void*,void*,void*),
+                            void *aux, int numThreads) {
+    UTL_ParallelApply pa = {
+        .list        = list,
+        .numThreads  = UTL_ParallelNumThreads(list, numThreads),
+        .visit       = &UTL_ParallelVisitReduce,
+        .aux         = aux,
+        .reduceFunc  = reduceFunc,
+        .stateSize   = stateSize,
+        .stateStride = stateSize
+    };
 
-    while (UTL_ListIterIsValid(&iter)) {
-        state = foldFunc(state, UTL_ListIterGet(&iter));
-        UTL_ListIterNext(&iter);
+    if (pa.numThreads == 1) {
+        pa.states = result;
+        UTL_ParallelApplyExec(&pa);
+        return;
     }
 
-    return state;
+    // the states are updated for every object, so each gets its own cache lines to keep the threads from
+    // invalidating each other's caches
+    pa.stateStride = (stateSize + UTL_PARALLEL_CACHE_LINE - 1) & ~(size_t)(UTL_PARALLEL_CACHE_LINE - 1);
+    void *memory = malloc(pa.stateStride * pa.numThreads + UTL_PARALLEL_CACHE_LINE - 1);
+    pa.states = (uint8_t*) (((uintptr_t) memory + UTL_PARALLEL_CACHE_LINE - 1) & ~(uintptr_t)(UTL_PARALLEL_CACHE_LINE - 1));
+    for (int i = 0; i < pa.numThreads; i++)
+        memcpy(pa.states + pa.stateStride * i, result, stateSize);
+
+    UTL_ParallelApplyExec(&pa);
+
+    for (int i = 0; i < pa.numThreads; i++)
+        combineFunc(aux, result, pa.states + pa.stateStride * i);
+    free(memory);
 }
 
 
@@ -388,6 +4518,12 @@ UTL_ListIter UTL_ListGetIteratorAt(UTL_List *list, int at) {
             return UTL_ArrayListGetIteratorAt((UTL_ArrayList*) list, at);
         case UTL_LINKED_LIST:
             return UTL_LinkedListGetIteratorAt((UTL_LinkedList*) list, at);
+        case UTL_DEQUE_LIST:
+            return UTL_DequeListGetIteratorAt((UTL_DequeList*) list, at);
+        case UTL_UNROLLED_LIST:
+            return UTL_UnrolledListGetIteratorAt((UTL_UnrolledList*) list, at);
+        case UTL_TREE_LIST:
+            return UTL_TreeListGetIteratorAt((UTL_TreeList*) list, at);
         default:
             return (UTL_ListIter) { .list = NULL, .auxData = NULL, .index = 0 };
     }
@@ -424,10 +4560,23 @@ void UTL_ListIterNext(UTL_ListIter *iter) {
 
         switch (iter->list->listType) {
             case UTL_ARRAY_LIST:
+            case UTL_DEQUE_LIST:
                 break;
             case UTL_LINKED_LIST:
                 iter->auxData = ((UTL_LinkedListNode*)(iter->auxData))->next;
                 break;
+            case UTL_UNROLLED_LIST:
+                if (++iter->auxIndex == ((UTL_UnrolledListChunk*)(iter->auxData))->count) {
+                    iter->auxData  = ((UTL_UnrolledListChunk*)(iter->auxData))->next;
+                    iter->auxIndex = 0;
+                }
+                break;
+            case UTL_TREE_LIST:
+                if (++iter->auxIndex == ((UTL_TreeListLeaf*)(iter->auxData))->node.size) {
+                    iter->auxData  = ((UTL_TreeListLeaf*)(iter->auxData))->next;
+                    iter->auxIndex = 0;
+                }
+                break;
             default:
                 break;
         }
@@ -443,10 +4592,25 @@ void UTL_ListIterPrev(UTL_ListIter *iter) {
 
         switch (iter->list->listType) {
             case UTL_ARRAY_LIST:
+            case UTL_DEQUE_LIST:
                 break;
             case UTL_LINKED_LIST:
                 iter->auxData = ((UTL_LinkedListNode*)(iter->auxData))->prev;
                 break;
+            case UTL_UNROLLED_LIST:
+                if (--iter->auxIndex < 0) {
+                    UTL_UnrolledListChunk *prev = ((UTL_UnrolledListChunk*)(iter->auxData))->prev;
+                    iter->auxData  = prev;
+                    iter->auxIndex = prev ? prev->count - 1 : 0;
+                }
+                break;
+            case UTL_TREE_LIST:
+                if (--iter->auxIndex < 0) {
+                    UTL_TreeListLeaf *prev = ((UTL_TreeListLeaf*)(iter->auxData))->prev;
+                    iter->auxData  = prev;
+                    iter->auxIndex = prev ? prev->node.size - 1 : 0;
+                }
+                break;
             default:
                 break;
         }
@@ -466,6 +4630,15 @@ void* UTL_ListIterGet(UTL_ListIter *iter) {
         case UTL_LINKED_LIST:
             pos = ((UTL_LinkedListNode*)iter->auxData)->obj;
             break;
+        case UTL_DEQUE_LIST:
+            pos = UTL_DequeListAt(((UTL_DequeList*) iter->list), iter->index);
+            break;
+        case UTL_UNROLLED_LIST:
+            pos = UTL_UnrolledListAt(iter->list, (UTL_UnrolledListChunk*)iter->auxData, iter->auxIndex);
+            break;
+        case UTL_TREE_LIST:
+            pos = UTL_TreeListAt(iter->list, (UTL_TreeListLeaf*)iter->auxData, iter->auxIndex);
+            break;
         default:
             pos = NULL;
             break;
@@ -476,7 +4649,8 @@ void* UTL_ListIterGet(UTL_ListIter *iter) {
 
 
 void UTL_ListIterSet(UTL_ListIter *iter, void *obj) {
-    if (!iter->list) return;
+    if (!UTL_ListIterIsValid(iter)) return;
+    UTL_ListMakeWritable(iter->list);
 
     uint8_t *pos;
 
@@ -487,6 +4661,15 @@ void UTL_ListIterSet(UTL_ListIter *iter, void *obj) {
         case UTL_LINKED_LIST:
             pos = ((UTL_LinkedListNode*)iter->auxData)->obj;
             break;
+        case UTL_DEQUE_LIST:
+            pos = UTL_DequeListAt(((UTL_DequeList*) iter->list), iter->index);
+            break;
+        case UTL_UNROLLED_LIST:
+            pos = UTL_UnrolledListAt(iter->list, (UTL_UnrolledListChunk*)iter->auxData, iter->auxIndex);
+            break;
+        case UTL_TREE_LIST:
+            pos = UTL_TreeListAt(iter->list, (UTL_TreeListLeaf*)iter->auxData, iter->auxIndex);
+            break;
         default:
             pos = NULL;
             break;
@@ -495,9 +4678,434 @@ void UTL_ListIterSet(UTL_ListIter *iter, void *obj) {
     memcpy(pos, UTL_ListObj2Pos(iter->list, obj), UTL_ListDataSize(iter->list));
 }
 
+void UTL_ListIterInsert(UTL_ListIter *iter, void *obj) {
+    if (!UTL_ListIterIsValid(iter)) return;
+
+    switch (iter->list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListInsert((UTL_ArrayList*) iter->list, iter->index, obj);
+            break;
+        case UTL_LINKED_LIST:
+            UTL_LinkedListInsertBefore((UTL_LinkedList*) iter->list, iter->auxData, obj);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListInsert((UTL_DequeList*) iter->list, iter->index, obj);
+            break;
+        case UTL_UNROLLED_LIST: {
+            // the new object takes the iterator's position, move on to the object behind it
+            UTL_UnrolledListChunk *chunk = UTL_UnrolledListInsertAt((UTL_UnrolledList*) iter->list, iter->auxData, &iter->auxIndex, obj);
+            iter->auxData = chunk;
+            if (++iter->auxIndex == chunk->count) {
+                iter->auxData  = chunk->next;
+                iter->auxIndex = 0;
+            }
+            break;
+        }
+        case UTL_TREE_LIST: {
+            UTL_TreeListLeaf *leaf = UTL_TreeListInsertAt((UTL_TreeList*) iter->list, iter->auxData, &iter->auxIndex, obj);
+            iter->auxData = leaf;
+            if (++iter->auxIndex == leaf->node.size) {
+                iter->auxData  = leaf->next;
+                iter->auxIndex = 0;
+            }
+            break;
+        }
+        default:
+            return;
+    }
+
+    iter->index++;
+}
+
+
 void UTL_ListIterRemove(UTL_ListIter *iter) {
-    (void) iter;
-    // TODO
+    if (!UTL_ListIterIsValid(iter)) return;
+    UTL_ListMakeWritable(iter->list);
+
+    switch (iter->list->listType) {
+        case UTL_ARRAY_LIST:
+            UTL_ArrayListRemove((UTL_ArrayList*) iter->list, iter->index);
+            break;
+        case UTL_LINKED_LIST:
+            iter->auxData = UTL_LinkedListRemoveNode((UTL_LinkedList*) iter->list, iter->auxData);
+            break;
+        case UTL_DEQUE_LIST:
+            UTL_DequeListRemove((UTL_DequeList*) iter->list, iter->index);
+            break;
+        case UTL_UNROLLED_LIST:
+            iter->auxData = UTL_UnrolledListRemoveAt((UTL_UnrolledList*) iter->list, iter->auxData, &iter->auxIndex, 1);
+            break;
+        case UTL_TREE_LIST:
+            // rebalancing may move objects between leaves -> locate the following object again
+            UTL_TreeListRemoveAt((UTL_TreeList*) iter->list, iter->auxData, iter->auxIndex, 1);
+            if (iter->index < iter->list->count)
+                iter->auxData = UTL_TreeListLocate((UTL_TreeList*) iter->list, iter->index, &iter->auxIndex);
+            else
+                iter->auxData = NULL;
+            break;
+        default:
+            break;
+    }
+}
+
+
+// list spans /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* set the span of an iterator starting at its index. for linked, unrolled and tree lists @auxData is the node,
+ * chunk or leaf the span starts in, and is moved on to where the next span starts */
+static void UTL_ListSpanIterLoad(UTL_ListSpanIter *iter) {
+    UTL_List *list = iter->list;
+    size_t dataSize = UTL_ListDataSize(list);
+
+    iter->span = (UTL_Span) { .ptr = NULL, .count = 0, .stride = dataSize };
+    if (iter->index >= list->count) return;
+
+    switch (list->listType) {
+        case UTL_ARRAY_LIST:
+            iter->span.ptr   = ((UTL_ArrayList*) list)->data;
+            iter->span.count = list->count;
+            break;
+        case UTL_DEQUE_LIST: {
+            // the objects wrap around at the end of the buffer at most once
+            UTL_DequeList *deque = (UTL_DequeList*) list;
+            int start = (deque->head + iter->index) & (deque->capacity - 1);
+            iter->span.ptr   = deque->data + dataSize * start;
+            iter->span.count = list->count - iter->index < deque->capacity - start ? list->count - iter->index : deque->capacity - start;
+            break;
+        }
+        case UTL_LINKED_LIST: {
+            // pools hand out nodes in address order, so nodes pushed one after another are often adjacent
+            UTL_LinkedListNode *node = iter->auxData;
+            size_t nodeSize = ((UTL_LinkedList*) list)->pool->nodeSize;
+            iter->span.ptr    = node->obj;
+            iter->span.count  = 1;
+            iter->span.stride = nodeSize;
+            while (iter->index + iter->span.count < list->count && (uint8_t*) node->next == (uint8_t*) node + nodeSize) {
+                node = node->next;
+                iter->span.count++;
+            }
+            iter->auxData = node->next;
+            break;
+        }
+        case UTL_UNROLLED_LIST: {
+            UTL_UnrolledListChunk *chunk = iter->auxData;
+            iter->span.ptr   = chunk->data;
+            iter->span.count = chunk->count;
+            iter->auxData    = chunk->next;
+            break;
+        }
+        case UTL_TREE_LIST: {
+            UTL_TreeListLeaf *leaf = iter->auxData;
+            iter->span.ptr   = leaf->data;
+            iter->span.count = leaf->node.size;
+            iter->auxData    = leaf->next;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+
+/** get an iterator over the contiguous runs of objects of a list */
+UTL_ListSpanIter UTL_ListGetSpanIter(UTL_List *list) {
+    UTL_ListSpanIter iter = { .list = list, .auxData = NULL, .index = 0 };
+
+    switch (list->listType) {
+        case UTL_LINKED_LIST:
+            iter.auxData = ((UTL_LinkedList*) list)->sentinel.next;
+            break;
+        case UTL_UNROLLED_LIST:
+            iter.auxData = ((UTL_UnrolledList*) list)->head;
+            break;
+        case UTL_TREE_LIST:
+            iter.auxData = ((UTL_TreeList*) list)->head;
+            break;
+        default:
+            break;
+    }
+
+    UTL_ListSpanIterLoad(&iter);
+    return iter;
+}
+
+
+bool UTL_ListSpanIterIsValid(UTL_ListSpanIter *iter) {
+    return iter->list != NULL && iter->span.count > 0;
+}
+
+
+void UTL_ListSpanIterNext(UTL_ListSpanIter *iter) {
+    if (!UTL_ListSpanIterIsValid(iter)) return;
+
+    iter->index += iter->span.count;
+    UTL_ListSpanIterLoad(iter);
+}
+
+
+/** copy up to @maxSpans spans of a list to @spans, returns the number of spans of the whole list */
+int UTL_ListGetSpans(UTL_List *list, UTL_Span *spans, int maxSpans) {
+    int numSpans = 0;
+
+    for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter)) {
+        if (numSpans < maxSpans) spans[numSpans] = iter.span;
+        numSpans++;
+    }
+
+    return numSpans;
+}
+
+
+// list files /////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/* identifies files written by UTL_ListSave(), the version changes whenever the layout does */
+#define UTL_LIST_FILE_MAGIC   "UTL_LIST"
+#define UTL_LIST_FILE_VERSION 1
+
+/* parameters of the 64 bit FNV-1a hash used as checksum */
+#define UTL_LIST_FILE_FNV_OFFSET 14695981039346656037ULL
+#define UTL_LIST_FILE_FNV_PRIME  1099511628211ULL
+
+
+/* header of a list file, the objects follow right behind it */
+typedef struct {
+    char     magic[8];      // UTL_LIST_FILE_MAGIC without terminating zero
+    uint32_t version;       // UTL_LIST_FILE_VERSION, also keeps files written with another byte order from loading
+    uint32_t dataSize;      // size of one object
+    uint64_t count;         // number of objects
+    uint64_t checksum;      // FNV-1a hash of the objects
+    char     typeName[32];  // name of the objects' type, zero padded and cut off if longer
+} UTL_ListFileHeader;
+
+// keeps the objects of a mapped file aligned to a cache line
+_STATIC_ASSERT(sizeof(UTL_ListFileHeader) == 64);
+
+
+static uint64_t UTL_ListFileChecksum(uint64_t hash, const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= UTL_LIST_FILE_FNV_PRIME;
+    }
+    return hash;
+}
+
+
+/* the name of a type as stored in list files */
+static void UTL_ListFileTypeName(const UTL_TypeInfo *dataType, char typeName[32]) {
+    memset(typeName, 0, 32);
+    if (!dataType->name) return;
+
+    size_t length = strlen(dataType->name);
+    memcpy(typeName, dataType->name, length < 32 ? length : 32);
+}
+
+
+/* does a file of @fileSize bytes starting with @header hold objects of type @dataType? */
+static bool UTL_ListFileMatches(const UTL_ListFileHeader *header, size_t fileSize, const UTL_TypeInfo *dataType) {
+    if (fileSize < sizeof(UTL_ListFileHeader)) return false;
+    if (memcmp(header->magic, UTL_LIST_FILE_MAGIC, sizeof(header->magic)) != 0) return false;
+    if (header->version != UTL_LIST_FILE_VERSION || header->dataSize != dataType->size || dataType->size == 0) return false;
+    if (header->count > INT_MAX || header->count > (fileSize - sizeof(UTL_ListFileHeader)) / dataType->size) return false;
+
+    char typeName[32];
+    UTL_ListFileTypeName(dataType, typeName);
+    return memcmp(header->typeName, typeName, sizeof(typeName)) == 0;
+}
+
+
+/** write the objects of a list storing objects by value to the file at @path, see UTL_ListMapFile().
+ *  returns false if the list stores objects by reference or the file can't be written */
+bool UTL_ListSave(UTL_List *list, const char *path) {
+    if (list->byRef) return false;
+
+    size_t dataSize = list->dataType->size;
+    UTL_ListFileHeader header = {
+        .version  = UTL_LIST_FILE_VERSION,
+        .dataSize = (uint32_t) dataSize,
+        .count    = (uint64_t) list->count,
+        .checksum = UTL_LIST_FILE_FNV_OFFSET
+    };
+    memcpy(header.magic, UTL_LIST_FILE_MAGIC, sizeof(header.magic));
+    UTL_ListFileTypeName(list->dataType, header.typeName);
+
+    // whole spans are hashed and written at once where the objects are packed
+    for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter)) {
+        const uint8_t *pos = iter.span.ptr;
+        if (iter.span.stride == dataSize)
+            header.checksum = UTL_ListFileChecksum(header.checksum, pos, dataSize * iter.span.count);
+        else for (int k = 0; k < iter.span.count; k++)
+            header.checksum = UTL_ListFileChecksum(header.checksum, pos + iter.span.stride * k, dataSize);
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); written && UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter)) {
+        const uint8_t *pos = iter.span.ptr;
+        if (iter.span.stride == dataSize)
+            written = fwrite(pos, dataSize, iter.span.count, file) == (size_t) iter.span.count;
+        else for (int k = 0; written && k < iter.span.count; k++)
+            written = fwrite(pos + iter.span.stride * k, dataSize, 1, file) == 1;
+    }
+
+    if (fclose(file) != 0) written = false;
+    return written;
+}
+
+
+// list snapshots /////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+typedef struct UTL_ListSnapshotImpl UTL_ListSnapshotImpl;
+struct UTL_ListSnapshotImpl {
+    const UTL_TypeInfo *dataType;  // see UTL_ListSnapshot
+    bool                byRef;     // see UTL_ListSnapshot
+    int                 count;     // see UTL_ListSnapshot
+
+    atomic_int            refCount;  // number of owners, the snapshot is freed when it drops to 0
+    UTL_ListSnapshotImpl *retired;   // next snapshot on the retired list of a slot
+    uint8_t               data[];    // the objects, allocated together with the snapshot
+};
+
+_STATIC_ASSERT(offsetof(UTL_ListSnapshot, dataType) == offsetof(UTL_ListSnapshotImpl, dataType));
+_STATIC_ASSERT(offsetof(UTL_ListSnapshot, byRef)    == offsetof(UTL_ListSnapshotImpl, byRef));
+_STATIC_ASSERT(offsetof(UTL_ListSnapshot, count)    == offsetof(UTL_ListSnapshotImpl, count));
+
+
+/* readers pin the current snapshot of a slot by loading it and taking a reference. a snapshot replaced by a publish
+ * is retired instead of released right away, because a reader might have loaded it but not taken its reference yet.
+ * retired snapshots are released once no reader is pinning, which means every reader that saw them took a reference */
+struct UTL_ListSnapshotSlot {
+    _Atomic(UTL_ListSnapshotImpl*) current;  // the published snapshot, NULL before the first publish
+    atomic_int                     pinning;  // number of readers between loading @current and taking a reference
+    pthread_mutex_t                mutex;    // serializes publishers, guards @retired
+    UTL_ListSnapshotImpl          *retired;  // replaced snapshots, the slot still holds a reference to each
+};
+
+
+#define UTL_ListSnapshotDataSize(snapshot) ((snapshot)->byRef ? sizeof(void*) : (snapshot)->dataType->size)
+
+
+/* release the retired snapshots of a slot if no reader is pinning */
+static void UTL_ListSnapshotSlotReclaim(UTL_ListSnapshotSlot *slot) {
+    if (atomic_load(&slot->pinning) > 0) return;
+
+    while (slot->retired) {
+        UTL_ListSnapshotImpl *snapshot = slot->retired;
+        slot->retired = snapshot->retired;
+        UTL_ListSnapshotRelease((UTL_ListSnapshot*) snapshot);
+    }
+}
+
+
+/** copy the objects of a list into a new immutable snapshot, allocated as a single block of exactly the needed size */
+UTL_ListSnapshot* UTL_ListFreeze(UTL_List *list) {
+    size_t dataSize = UTL_ListDataSize(list);
+    UTL_ListSnapshotImpl *snapshot = malloc(sizeof(UTL_ListSnapshotImpl) + dataSize * list->count);
+
+    snapshot->dataType = list->dataType;
+    snapshot->byRef    = list->byRef;
+    snapshot->count    = list->count;
+    snapshot->retired  = NULL;
+    atomic_init(&snapshot->refCount, 1);
+
+    uint8_t *pos = snapshot->data;
+    for (UTL_ListSpanIter iter = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&iter); UTL_ListSpanIterNext(&iter)) {
+        if (iter.span.stride == dataSize) {
+            memcpy(pos, iter.span.ptr, dataSize * iter.span.count);
+            pos += dataSize * iter.span.count;
+        }
+        else for (int k = 0; k < iter.span.count; k++, pos += dataSize) {
+            memcpy(pos, (uint8_t*) iter.span.ptr + iter.span.stride * k, dataSize);
+        }
+    }
+
+    return (UTL_ListSnapshot*) snapshot;
+}
+
+
+/** the object at index @at of the snapshot, NULL if out of bounds */
+const void* UTL_ListSnapshotGet(const UTL_ListSnapshot *snapshot, int at) {
+    const UTL_ListSnapshotImpl *impl = (const UTL_ListSnapshotImpl*) snapshot;
+    if (at < 0 || at >= impl->count) return NULL;
+
+    const uint8_t *pos = impl->data + UTL_ListSnapshotDataSize(impl) * at;
+    return impl->byRef ? *(void* const*) pos : pos;
+}
+
+
+/** span over all objects of the snapshot */
+UTL_Span UTL_ListSnapshotGetSpan(const UTL_ListSnapshot *snapshot) {
+    const UTL_ListSnapshotImpl *impl = (const UTL_ListSnapshotImpl*) snapshot;
+    return (UTL_Span) { .ptr = (void*) impl->data, .count = impl->count, .stride = UTL_ListSnapshotDataSize(impl) };
+}
+
+
+/** take another reference to a snapshot */
+void UTL_ListSnapshotRetain(UTL_ListSnapshot *snapshot) {
+    atomic_fetch_add_explicit(&((UTL_ListSnapshotImpl*) snapshot)->refCount, 1, memory_order_relaxed);
+}
+
+
+/** drop a reference to a snapshot, the last one frees it */
+void UTL_ListSnapshotRelease(UTL_ListSnapshot *snapshot) {
+    UTL_ListSnapshotImpl *impl = (UTL_ListSnapshotImpl*) snapshot;
+    if (atomic_fetch_sub_explicit(&impl->refCount, 1, memory_order_acq_rel) == 1) free(impl);
+}
+
+
+/** make @snapshot the current snapshot of the slot, taking over the caller's reference to it.
+ *  the replaced snapshot is released once no reader can be about to pin it */
+void UTL_ListSnapshotPublish(UTL_ListSnapshotSlot *slot, UTL_ListSnapshot *snapshot) {
+    pthread_mutex_lock(&slot->mutex);
+
+    UTL_ListSnapshotImpl *old = atomic_exchange(&slot->current, (UTL_ListSnapshotImpl*) snapshot);
+    if (old) {
+        old->retired  = slot->retired;
+        slot->retired = old;
+    }
+    UTL_ListSnapshotSlotReclaim(slot);
+
+    pthread_mutex_unlock(&slot->mutex);
+}
+
+
+/** take a reference to the current snapshot of the slot, NULL if nothing was published yet */
+UTL_ListSnapshot* UTL_ListSnapshotPin(UTL_ListSnapshotSlot *slot) {
+    atomic_fetch_add(&slot->pinning, 1);
+
+    UTL_ListSnapshotImpl *snapshot = atomic_load(&slot->current);
+    if (snapshot) UTL_ListSnapshotRetain((UTL_ListSnapshot*) snapshot);
+
+    atomic_fetch_sub(&slot->pinning, 1);
+    return (UTL_ListSnapshot*) snapshot;
+}
+
+
+/** create a new slot for publishing snapshots, holding none yet */
+UTL_ListSnapshotSlot* UTL_ListSnapshotSlotCreate(void) {
+    UTL_ListSnapshotSlot *slot = malloc(sizeof(UTL_ListSnapshotSlot));
+
+    atomic_init(&slot->current, NULL);
+    atomic_init(&slot->pinning, 0);
+    pthread_mutex_init(&slot->mutex, NULL);
+    slot->retired = NULL;
+
+    return slot;
+}
+
+
+/** free a slot and drop its references to the current and retired snapshots. no reader may be pinning anymore */
+void UTL_ListSnapshotSlotDestroy(UTL_ListSnapshotSlot *slot) {
+    UTL_ListSnapshotImpl *current = atomic_load(&slot->current);
+    if (current) UTL_ListSnapshotRelease((UTL_ListSnapshot*) current);
+
+    UTL_ListSnapshotSlotReclaim(slot);
+    pthread_mutex_destroy(&slot->mutex);
+    free(slot);
 }
 
 
@@ -505,25 +5113,31 @@ void UTL_ListIterRemove(UTL_ListIter *iter) {
 
 
 /** create a new list, storing objects directly, backed by an array */
-static UTL_List* UTL_ArrayListCreate(const UTL_TypeInfo *dataType, bool byRef) {
-    UTL_ArrayList *list = (UTL_ArrayList*) malloc(sizeof(UTL_ArrayList));
+static UTL_List* UTL_ArrayListCreate(const UTL_TypeInfo *dataType, bool byRef, int inlineCapacity) {
+    size_t dataSize = byRef ? sizeof(void*) : dataType->size;
+    UTL_ArrayList *list = (UTL_ArrayList*) malloc(sizeof(UTL_ArrayList) + dataSize * inlineCapacity);
 
     list->listType = UTL_ARRAY_LIST;
     list->dataType = dataType;
     list->byRef    = byRef;
 
 
-    list->capacity = UTL_ARRAY_LIST_INITIAL_CAPACITY;
+    // without inline buffer the buffer is allocated on the first push
+    list->capacity       = inlineCapacity;
+    list->inlineCapacity = inlineCapacity;
     list->count = 0;
 
-    list->data = malloc(UTL_ListDataSize(list) * list->capacity);
+    list->data = inlineCapacity > 0 ? list->inlineData : NULL;
+    list->mapping     = NULL;
+    list->mappingSize = 0;
 
     return (UTL_List*) list;
 }
 
 
-/** create a new list, storing objects directly, backed by linked nodes */
-static UTL_List* UTL_LinkedListCreate(const UTL_TypeInfo *dataType, bool byRef) {
+/** create a new list, storing objects directly, backed by linked nodes.
+ *  nodes are allocated from @pool if given, or from a private pool otherwise */
+static UTL_List* UTL_LinkedListCreate(const UTL_TypeInfo *dataType, bool byRef, UTL_ListNodePool *pool) {
     UTL_LinkedList *list = (UTL_LinkedList*) malloc(sizeof(UTL_LinkedList));
 
     list->listType = UTL_LINKED_LIST;
@@ -534,6 +5148,76 @@ static UTL_List* UTL_LinkedListCreate(const UTL_TypeInfo *dataType, bool byRef)
     list->sentinel.next = &list->sentinel;
     list->sentinel.prev = &list->sentinel;
 
+    UTL_ListNodePoolInit(&list->ownPool, UTL_ListDataSize(list));
+    if (pool) {
+        pool->refCount++;
+        list->pool = pool;
+    }
+    else {
+        list->pool = &list->ownPool;
+    }
+
+    return (UTL_List*) list;
+}
+
+
+/** create a new list, storing objects directly, backed by a circular buffer */
+static UTL_List* UTL_DequeListCreate(const UTL_TypeInfo *dataType, bool byRef) {
+    UTL_DequeList *list = (UTL_DequeList*) malloc(sizeof(UTL_DequeList));
+
+    list->listType = UTL_DEQUE_LIST;
+    list->dataType = dataType;
+    list->byRef    = byRef;
+
+    // the buffer is allocated on the first push
+    list->capacity = 0;
+    list->count = 0;
+    list->head  = 0;
+
+    list->data = NULL;
+
+    return (UTL_List*) list;
+}
+
+
+/** create a new list, storing objects directly, backed by a B+tree */
+static UTL_List* UTL_TreeListCreate(const UTL_TypeInfo *dataType, bool byRef) {
+    UTL_TreeList *list = (UTL_TreeList*) malloc(sizeof(UTL_TreeList));
+
+    list->listType = UTL_TREE_LIST;
+    list->dataType = dataType;
+    list->byRef    = byRef;
+    list->count    = 0;
+
+    size_t dataSize = UTL_ListDataSize(list);
+    list->leafCapacity = dataSize ? UTL_TREE_LIST_LEAF_BYTES / (int) dataSize : UTL_TREE_LIST_MIN_LEAF_CAPACITY;
+    if (list->leafCapacity < UTL_TREE_LIST_MIN_LEAF_CAPACITY) list->leafCapacity = UTL_TREE_LIST_MIN_LEAF_CAPACITY;
+
+    list->height = 0;
+    list->head   = NULL;
+    list->tail   = NULL;
+    list->root   = &UTL_TreeListLinkLeaf(list, NULL)->node;
+
+    return (UTL_List*) list;
+}
+
+
+/** create a new list, storing objects directly, backed by linked chunks of objects */
+static UTL_List* UTL_UnrolledListCreate(const UTL_TypeInfo *dataType, bool byRef) {
+    UTL_UnrolledList *list = (UTL_UnrolledList*) malloc(sizeof(UTL_UnrolledList));
+
+    list->listType = UTL_UNROLLED_LIST;
+    list->dataType = dataType;
+    list->byRef    = byRef;
+
+    list->count = 0;
+    list->head  = NULL;
+    list->tail  = NULL;
+
+    size_t dataSize = UTL_ListDataSize(list);
+    list->chunkCapacity = dataSize ? UTL_UNROLLED_LIST_CHUNK_BYTES / dataSize : UTL_UNROLLED_LIST_MIN_CHUNK_CAPACITY;
+    if (list->chunkCapacity < UTL_UNROLLED_LIST_MIN_CHUNK_CAPACITY) list->chunkCapacity = UTL_UNROLLED_LIST_MIN_CHUNK_CAPACITY;
+
     return (UTL_List*) list;
 }
 
@@ -545,10 +5229,75 @@ static UTL_List* UTL_LinkedListCreate(const UTL_TypeInfo *dataType, bool byRef)
 UTL_List* UTL_ListCreate(UTL_ListType listType, const UTL_TypeInfo *dataType, bool byRef) {
     switch (listType) {
         case UTL_ARRAY_LIST:
-            return UTL_ArrayListCreate(dataType, byRef);
+            return UTL_ArrayListCreate(dataType, byRef, 0);
         case UTL_LINKED_LIST:
-            return UTL_LinkedListCreate(dataType, byRef);
+            return UTL_LinkedListCreate(dataType, byRef, NULL);
+        case UTL_DEQUE_LIST:
+            return UTL_DequeListCreate(dataType, byRef);
+        case UTL_UNROLLED_LIST:
+            return UTL_UnrolledListCreate(dataType, byRef);
+        case UTL_TREE_LIST:
+            return UTL_TreeListCreate(dataType, byRef);
         default:
             return NULL;
     }
+}
+
+
+/** create a pool of nodes, that can be shared by linked lists storing objects of the given type.
+ *  the pool stays alive until it was destroyed and all lists using it were destroyed */
+UTL_ListNodePool* UTL_ListNodePoolCreate(const UTL_TypeInfo *dataType, bool byRef) {
+    UTL_ListNodePool *pool = (UTL_ListNodePool*) malloc(sizeof(UTL_ListNodePool));
+    UTL_ListNodePoolInit(pool, byRef ? sizeof(void*) : dataType->size);
+    return pool;
+}
+
+
+/** release the handle to a node pool returned by UTL_ListNodePoolCreate() */
+void UTL_ListNodePoolDestroy(UTL_ListNodePool *pool) {
+    UTL_ListNodePoolRelease(pool);
+}
+
+
+/** create a new linked list, allocating its nodes from a shared @pool.
+ *  returns NULL if the pool was created for objects of a different size */
+UTL_List* UTL_ListCreateWithPool(const UTL_TypeInfo *dataType, bool byRef, UTL_ListNodePool *pool) {
+    size_t dataSize = byRef ? sizeof(void*) : dataType->size;
+    if (UTL_GenericAddPadding(sizeof(UTL_LinkedListNode) + dataSize) != pool->nodeSize) return NULL;
+
+    return UTL_LinkedListCreate(dataType, byRef, pool);
+}
+
+
+/** create a new array list with an inline buffer for @inlineCapacity objects, allocated together with the list.
+ *  objects move to the heap when the list outgrows the inline buffer */
+UTL_List* UTL_ListCreateWithInlineBuffer(const UTL_TypeInfo *dataType, bool byRef, int inlineCapacity) {
+    return UTL_ArrayListCreate(dataType, byRef, inlineCapacity > 0 ? inlineCapacity : 0);
+}
+
+
+/** create an array list of the objects in a file written by UTL_ListSave(). the list is backed directly by a read only
+ *  mapping of the file, so nothing is copied until the list is changed. returns NULL if the file can't be mapped or holds objects
+ *  of another type, or if @verify is set and the checksum of the objects does not match, which reads the whole file */
+UTL_List* UTL_ListMapFile(const char *path, const UTL_TypeInfo *dataType, bool verify) {
+    size_t size;
+    uint8_t *mapping = UTL_MapFile(path, &size);
+    if (!mapping) return NULL;
+
+    const UTL_ListFileHeader *header = (const UTL_ListFileHeader*) mapping;
+    uint8_t *data = mapping + sizeof(UTL_ListFileHeader);
+    if (!UTL_ListFileMatches(header, size, dataType) ||
+        (verify && UTL_ListFileChecksum(UTL_LIST_FILE_FNV_OFFSET, data, dataType->size * header->count) != header->checksum)) {
+        UTL_UnmapFile(mapping, size);
+        return NULL;
+    }
+
+    UTL_ArrayList *list = (UTL_ArrayList*) UTL_ArrayListCreate(dataType, false, 0);
+    list->count       = (int) header->count;
+    list->capacity    = list->count;
+    list->data        = data;
+    list->mapping     = mapping;
+    list->mappingSize = size;
+
+    return (UTL_List*) list;
 }
\ No newline at end of file
@@ -0,0 +1,295 @@
+#include "UTL/UTL.h"
+
+
+/* number of children of a heap node. wider nodes make the heap flatter and keep siblings on one cache line */
+#define UTL_PRIORITY_QUEUE_ARITY 4
+
+/* capacity allocated on the first push, queues are created without a buffer */
+#define UTL_PRIORITY_QUEUE_INITIAL_CAPACITY 16
+
+
+
+/** d-ary min heap over a contiguous buffer. every heap slot knows the handle of its object,
+ *  and every handle its slot, so objects can be found and moved by handle */
+typedef struct {
+    const UTL_TypeInfo *dataType;  // see UTL_PriorityQueue
+    bool                byRef;     // see UTL_PriorityQueue
+    int                 count;     // see UTL_PriorityQueue
+
+    int      capacity;     // number of objects the heap holds
+    size_t   dataSize;     // size of one stored object
+    uint8_t *data;         // the heap of objects
+    int     *handles;      // handle of the object in each heap slot
+    uint8_t *temp;         // one object, held while sifting
+
+    int  numHandles;       // number of handles ever given out
+    int *slots;            // heap slot of each handle, -1 if the handle is not in the queue
+    int *freeHandles;      // handles to reuse
+    int  numFreeHandles;
+} UTL_PriorityQueueImpl;
+
+
+_STATIC_ASSERT(offsetof(UTL_PriorityQueue, dataType) == offsetof(UTL_PriorityQueueImpl, dataType));
+_STATIC_ASSERT(offsetof(UTL_PriorityQueue, byRef)    == offsetof(UTL_PriorityQueueImpl, byRef));
+_STATIC_ASSERT(offsetof(UTL_PriorityQueue, count)    == offsetof(UTL_PriorityQueueImpl, count));
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define UTL_PriorityQueueAt(queue, slot) ((queue)->data + (queue)->dataSize * (size_t)(slot))
+
+#define UTL_PriorityQueuePos2Obj(queue, pos) ((queue)->byRef ? *((void**)(pos)) : (void*)(pos))
+
+#define UTL_PriorityQueueLess(queue, pos1, pos2) \
+    ((queue)->dataType->cmpFunc(UTL_PriorityQueuePos2Obj(queue, pos1), UTL_PriorityQueuePos2Obj(queue, pos2)) < 0)
+
+
+static void UTL_PriorityQueueSetCapacity(UTL_PriorityQueueImpl *queue, int capacity) {
+    queue->data        = realloc(queue->data,        queue->dataSize * capacity);
+    queue->handles     = realloc(queue->handles,     sizeof(int) * capacity);
+    queue->slots       = realloc(queue->slots,       sizeof(int) * capacity);
+    queue->freeHandles = realloc(queue->freeHandles, sizeof(int) * capacity);
+    queue->capacity    = capacity;
+}
+
+
+/* move the object at @slot up towards the root until its parent is not larger */
+static void UTL_PriorityQueueSiftUp(UTL_PriorityQueueImpl *queue, int slot) {
+    int handle = queue->handles[slot];
+    memcpy(queue->temp, UTL_PriorityQueueAt(queue, slot), queue->dataSize);
+
+    // move larger parents down into the hole, then drop the object into it
+    while (slot > 0) {
+        int parent = (slot - 1) / UTL_PRIORITY_QUEUE_ARITY;
+        if (!UTL_PriorityQueueLess(queue, queue->temp, UTL_PriorityQueueAt(queue, parent))) break;
+
+        memcpy(UTL_PriorityQueueAt(queue, slot), UTL_PriorityQueueAt(queue, parent), queue->dataSize);
+        queue->handles[slot] = queue->handles[parent];
+        queue->slots[queue->handles[slot]] = slot;
+        slot = parent;
+    }
+
+    memcpy(UTL_PriorityQueueAt(queue, slot), queue->temp, queue->dataSize);
+    queue->handles[slot] = handle;
+    queue->slots[handle] = slot;
+}
+
+
+/* move the object at @slot down towards the leaves until none of its children is smaller */
+static void UTL_PriorityQueueSiftDown(UTL_PriorityQueueImpl *queue, int slot) {
+    int handle = queue->handles[slot];
+    memcpy(queue->temp, UTL_PriorityQueueAt(queue, slot), queue->dataSize);
+
+    for (;;) {
+        int first = slot * UTL_PRIORITY_QUEUE_ARITY + 1;
+        if (first >= queue->count) break;
+
+        int last  = first + UTL_PRIORITY_QUEUE_ARITY < queue->count ? first + UTL_PRIORITY_QUEUE_ARITY : queue->count;
+        int child = first;
+        for (int c = first + 1; c < last; c++)
+            if (UTL_PriorityQueueLess(queue, UTL_PriorityQueueAt(queue, c), UTL_PriorityQueueAt(queue, child))) child = c;
+
+        if (!UTL_PriorityQueueLess(queue, UTL_PriorityQueueAt(queue, child), queue->temp)) break;
+
+        memcpy(UTL_PriorityQueueAt(queue, slot), UTL_PriorityQueueAt(queue, child), queue->dataSize);
+        queue->handles[slot] = queue->handles[child];
+        queue->slots[queue->handles[slot]] = slot;
+        slot = child;
+    }
+
+    memcpy(UTL_PriorityQueueAt(queue, slot), queue->temp, queue->dataSize);
+    queue->handles[slot] = handle;
+    queue->slots[handle] = slot;
+}
+
+
+/* take the object out of @slot, filling the hole with the last object */
+static void UTL_PriorityQueueRemoveSlot(UTL_PriorityQueueImpl *queue, int slot) {
+    int handle = queue->handles[slot];
+    queue->slots[handle] = -1;
+    queue->freeHandles[queue->numFreeHandles++] = handle;
+
+    queue->count--;
+    if (slot == queue->count) return;
+
+    memcpy(UTL_PriorityQueueAt(queue, slot), UTL_PriorityQueueAt(queue, queue->count), queue->dataSize);
+    queue->handles[slot] = queue->handles[queue->count];
+    queue->slots[queue->handles[slot]] = slot;
+
+    // the moved object may belong above or below its new slot
+    if (slot > 0 && UTL_PriorityQueueLess(queue, UTL_PriorityQueueAt(queue, slot),
+                                          UTL_PriorityQueueAt(queue, (slot - 1) / UTL_PRIORITY_QUEUE_ARITY)))
+        UTL_PriorityQueueSiftUp(queue, slot);
+    else
+        UTL_PriorityQueueSiftDown(queue, slot);
+}
+
+
+static bool UTL_PriorityQueueValidHandle(UTL_PriorityQueueImpl *queue, int handle) {
+    return handle >= 0 && handle < queue->numHandles && queue->slots[handle] >= 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** add an object to the queue, returns the handle of the object */
+int UTL_PriorityQueuePush(UTL_PriorityQueue *queue, void *obj) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+
+    if (impl->numHandles == impl->capacity && impl->numFreeHandles == 0)
+        UTL_PriorityQueueSetCapacity(impl, impl->capacity ? impl->capacity * 2 : UTL_PRIORITY_QUEUE_INITIAL_CAPACITY);
+
+    int handle = impl->numFreeHandles ? impl->freeHandles[--impl->numFreeHandles] : impl->numHandles++;
+
+    int slot = impl->count++;
+    memcpy(UTL_PriorityQueueAt(impl, slot), impl->byRef ? (void*) &obj : obj, impl->dataSize);
+    impl->handles[slot] = handle;
+    UTL_PriorityQueueSiftUp(impl, slot);
+
+    return handle;
+}
+
+
+/** the smallest object of the queue, NULL if the queue is empty */
+void* UTL_PriorityQueuePeek(UTL_PriorityQueue *queue) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    if (!impl->count) return NULL;
+
+    return UTL_PriorityQueuePos2Obj(impl, impl->data);
+}
+
+
+/** handle of the smallest object of the queue, -1 if the queue is empty */
+int UTL_PriorityQueuePeekHandle(UTL_PriorityQueue *queue) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    return impl->count ? impl->handles[0] : -1;
+}
+
+
+/** remove the smallest object from the queue, copying it to @obj unless it is NULL */
+bool UTL_PriorityQueuePop(UTL_PriorityQueue *queue, void *obj) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    if (!impl->count) return false;
+
+    if (obj) memcpy(obj, impl->data, impl->dataSize);
+    UTL_PriorityQueueRemoveSlot(impl, 0);
+    return true;
+}
+
+
+/** the object with the given handle, NULL if the handle is not in the queue */
+void* UTL_PriorityQueueGet(UTL_PriorityQueue *queue, int handle) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    if (!UTL_PriorityQueueValidHandle(impl, handle)) return NULL;
+
+    return UTL_PriorityQueuePos2Obj(impl, UTL_PriorityQueueAt(impl, impl->slots[handle]));
+}
+
+
+/** is the object with the given handle in the queue? */
+bool UTL_PriorityQueueContains(UTL_PriorityQueue *queue, int handle) {
+    return UTL_PriorityQueueValidHandle((UTL_PriorityQueueImpl*) queue, handle);
+}
+
+
+/** replace the object with the given handle by @obj, moving it to its new place in the queue */
+bool UTL_PriorityQueueUpdate(UTL_PriorityQueue *queue, int handle, void *obj) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    if (!UTL_PriorityQueueValidHandle(impl, handle)) return false;
+
+    int slot = impl->slots[handle];
+    uint8_t *pos = UTL_PriorityQueueAt(impl, slot);
+    bool smaller = impl->dataType->cmpFunc(obj, UTL_PriorityQueuePos2Obj(impl, pos)) < 0;
+
+    memcpy(pos, impl->byRef ? (void*) &obj : obj, impl->dataSize);
+    if (smaller) UTL_PriorityQueueSiftUp(impl, slot);
+    else         UTL_PriorityQueueSiftDown(impl, slot);
+    return true;
+}
+
+
+/** remove the object with the given handle from the queue */
+bool UTL_PriorityQueueRemove(UTL_PriorityQueue *queue, int handle) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    if (!UTL_PriorityQueueValidHandle(impl, handle)) return false;
+
+    UTL_PriorityQueueRemoveSlot(impl, impl->slots[handle]);
+    return true;
+}
+
+
+/** remove all objects from the queue, keeping its memory */
+void UTL_PriorityQueueClear(UTL_PriorityQueue *queue) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    impl->count          = 0;
+    impl->numHandles     = 0;
+    impl->numFreeHandles = 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new priority queue */
+UTL_PriorityQueue* UTL_PriorityQueueCreate(const UTL_TypeInfo *dataType, bool byRef) {
+    UTL_PriorityQueueImpl *queue = (UTL_PriorityQueueImpl*) malloc(sizeof(UTL_PriorityQueueImpl));
+
+    queue->dataType       = dataType;
+    queue->byRef          = byRef;
+    queue->count          = 0;
+    queue->capacity       = 0;
+    queue->dataSize       = byRef ? sizeof(void*) : dataType->size;
+    queue->data           = NULL;
+    queue->handles        = NULL;
+    queue->temp           = malloc(queue->dataSize);
+    queue->numHandles     = 0;
+    queue->slots          = NULL;
+    queue->freeHandles    = NULL;
+    queue->numFreeHandles = 0;
+
+    return (UTL_PriorityQueue*) queue;
+}
+
+
+/** create a new priority queue holding all objects of a list, the object at index i gets the handle i */
+UTL_PriorityQueue* UTL_PriorityQueueCreateFromList(UTL_List *list) {
+    UTL_PriorityQueueImpl *queue = (UTL_PriorityQueueImpl*) UTL_PriorityQueueCreate(list->dataType, list->byRef);
+    if (!list->count) return (UTL_PriorityQueue*) queue;
+
+    UTL_PriorityQueueSetCapacity(queue, list->count);
+
+    // copy the objects span by span, then heapify bottom up
+    UTL_ListSpanIter iter = UTL_ListGetSpanIter(list);
+    while (UTL_ListSpanIterIsValid(&iter)) {
+        for (int i = 0; i < iter.span.count; i++)
+            memcpy(UTL_PriorityQueueAt(queue, iter.index + i), (uint8_t*) iter.span.ptr + iter.span.stride * i, queue->dataSize);
+        UTL_ListSpanIterNext(&iter);
+    }
+
+    queue->count      = list->count;
+    queue->numHandles = list->count;
+    for (int i = 0; i < queue->count; i++) {
+        queue->handles[i] = i;
+        queue->slots[i]   = i;
+    }
+
+    for (int slot = (queue->count - 2) / UTL_PRIORITY_QUEUE_ARITY; slot >= 0; slot--)
+        UTL_PriorityQueueSiftDown(queue, slot);
+
+    return (UTL_PriorityQueue*) queue;
+}
+
+
+/** free the memory associated with the given priority queue */
+void UTL_PriorityQueueDestroy(UTL_PriorityQueue *queue) {
+    UTL_PriorityQueueImpl *impl = (UTL_PriorityQueueImpl*) queue;
+    free(impl->data);
+    free(impl->handles);
+    free(impl->slots);
+    free(impl->freeHandles);
+    free(impl->temp);
+    free(impl);
+}
@@ -0,0 +1,194 @@
+#include "UTL/UTL.h"
+
+#include <stdatomic.h>
+
+
+/* size of a cache line, the positions of producers and consumers are kept on separate lines */
+#define UTL_QUEUE_CACHE_LINE 64
+
+/* smallest capacity of a queue */
+#define UTL_QUEUE_MIN_CAPACITY 2
+
+
+
+/* a slot of the ring buffer. @sequence tells which round of the ring the slot is in:
+ * it equals the position of a push that may write it, or that position + 1 once the object can be popped */
+typedef struct {
+    atomic_size_t sequence;  // see above
+    uint8_t       data[];    // the object
+} UTL_QueueCell;
+
+
+/** bounded queue as a ring of sequence numbered cells (Dmitry Vyukov's MPMC queue).
+ *  producers and consumers claim positions with a compare and swap, and hand cells over through their sequence */
+typedef struct {
+    const UTL_TypeInfo *dataType;  // see UTL_Queue
+    bool                byRef;     // see UTL_Queue
+    int                 capacity;  // see UTL_Queue
+
+    size_t   mask;      // capacity - 1, maps positions to cells
+    size_t   cellSize;  // size of one cell including its object, padded for alignment
+    uint8_t *cells;     // the ring of cells
+
+    uint8_t       pad0[UTL_QUEUE_CACHE_LINE];
+    atomic_size_t pushPos;  // position of the next push
+    uint8_t       pad1[UTL_QUEUE_CACHE_LINE - sizeof(atomic_size_t)];
+    atomic_size_t popPos;   // position of the next pop
+    uint8_t       pad2[UTL_QUEUE_CACHE_LINE - sizeof(atomic_size_t)];
+} UTL_QueueImpl;
+
+
+_STATIC_ASSERT(offsetof(UTL_Queue, dataType) == offsetof(UTL_QueueImpl, dataType));
+_STATIC_ASSERT(offsetof(UTL_Queue, byRef)    == offsetof(UTL_QueueImpl, byRef));
+_STATIC_ASSERT(offsetof(UTL_Queue, capacity) == offsetof(UTL_QueueImpl, capacity));
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define UTL_QueueDataSize(queue) (queue->byRef ? sizeof(void*) : queue->dataType->size)
+
+#define UTL_QueueCellAt(queue, pos) ((UTL_QueueCell*) ((queue)->cells + (queue)->cellSize * ((pos) & (queue)->mask)))
+
+
+/* claim up to @n consecutive positions for pushing (@push) or popping, returns the number of claimed positions.
+ * a cell is ready for a push at position pos if its sequence is pos, and ready for a pop if its sequence is pos + 1 */
+static int UTL_QueueClaim(UTL_QueueImpl *queue, bool push, int n, size_t *first) {
+    atomic_size_t *claimPos = push ? &queue->pushPos : &queue->popPos;
+    size_t ready = push ? 0 : 1;
+    size_t pos = atomic_load_explicit(claimPos, memory_order_relaxed);
+
+    for (;;) {
+        size_t sequence = atomic_load_explicit(&UTL_QueueCellAt(queue, pos)->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t) sequence - (intptr_t) (pos + ready);
+
+        if (diff < 0) return 0;  // full, or empty
+        if (diff > 0) {
+            // another thread claimed this position already
+            pos = atomic_load_explicit(claimPos, memory_order_relaxed);
+            continue;
+        }
+
+        // the first cell is ready -> count how many of the following ones are ready too
+        int count = 1;
+        while (count < n &&
+               atomic_load_explicit(&UTL_QueueCellAt(queue, pos + count)->sequence, memory_order_acquire) == pos + count + ready)
+            count++;
+
+        if (atomic_compare_exchange_weak_explicit(claimPos, &pos, pos + count, memory_order_relaxed, memory_order_relaxed)) {
+            *first = pos;
+            return count;
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** push an object to the back of the queue. returns false without pushing if the queue is full */
+bool UTL_QueueTryPush(UTL_Queue *queue, void *obj) {
+    UTL_QueueImpl *impl = (UTL_QueueImpl*) queue;
+    size_t pos;
+
+    if (!UTL_QueueClaim(impl, true, 1, &pos)) return false;
+
+    UTL_QueueCell *cell = UTL_QueueCellAt(impl, pos);
+    memcpy(cell->data, impl->byRef ? (void*) &obj : obj, UTL_QueueDataSize(impl));
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return true;
+}
+
+
+/** pop the object at the front of the queue into @obj. returns false if the queue is empty */
+bool UTL_QueueTryPop(UTL_Queue *queue, void *obj) {
+    return UTL_QueueTryPopN(queue, obj, 1) == 1;
+}
+
+
+/** push up to @n objects to the back of the queue, returns the number of pushed objects */
+int UTL_QueueTryPushN(UTL_Queue *queue, const void *objs, int n) {
+    UTL_QueueImpl *impl = (UTL_QueueImpl*) queue;
+    size_t dataSize = UTL_QueueDataSize(impl);
+    size_t pos;
+
+    if (n <= 0) return 0;
+    int count = UTL_QueueClaim(impl, true, n, &pos);
+
+    for (int i = 0; i < count; i++) {
+        UTL_QueueCell *cell = UTL_QueueCellAt(impl, pos + i);
+        memcpy(cell->data, (const uint8_t*) objs + dataSize * i, dataSize);
+        atomic_store_explicit(&cell->sequence, pos + i + 1, memory_order_release);
+    }
+
+    return count;
+}
+
+
+/** pop up to @n objects from the front of the queue into @objs, returns the number of popped objects */
+int UTL_QueueTryPopN(UTL_Queue *queue, void *objs, int n) {
+    UTL_QueueImpl *impl = (UTL_QueueImpl*) queue;
+    size_t dataSize = UTL_QueueDataSize(impl);
+    size_t pos;
+
+    if (n <= 0) return 0;
+    int count = UTL_QueueClaim(impl, false, n, &pos);
+
+    // hand the cells back to the producers of the next round
+    for (int i = 0; i < count; i++) {
+        UTL_QueueCell *cell = UTL_QueueCellAt(impl, pos + i);
+        memcpy((uint8_t*) objs + dataSize * i, cell->data, dataSize);
+        atomic_store_explicit(&cell->sequence, pos + i + impl->mask + 1, memory_order_release);
+    }
+
+    return count;
+}
+
+
+/** number of objects in the queue. only a snapshot while other threads push or pop */
+int UTL_QueueCount(UTL_Queue *queue) {
+    UTL_QueueImpl *impl = (UTL_QueueImpl*) queue;
+
+    size_t popPos  = atomic_load_explicit(&impl->popPos,  memory_order_acquire);
+    size_t pushPos = atomic_load_explicit(&impl->pushPos, memory_order_acquire);
+
+    // the positions are read one after the other, pops may have overtaken the pushes read
+    intptr_t count = (intptr_t) (pushPos - popPos);
+    if (count < 0) return 0;
+    if (count > impl->capacity) return impl->capacity;
+    return (int) count;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new queue for up to @capacity objects, rounded up to a power of two */
+UTL_Queue* UTL_QueueCreate(const UTL_TypeInfo *dataType, bool byRef, int capacity) {
+    UTL_QueueImpl *queue = (UTL_QueueImpl*) malloc(sizeof(UTL_QueueImpl));
+
+    queue->dataType = dataType;
+    queue->byRef    = byRef;
+    queue->capacity = UTL_QUEUE_MIN_CAPACITY;
+    while (queue->capacity < capacity) queue->capacity *= 2;
+
+    queue->mask     = (size_t) queue->capacity - 1;
+    queue->cellSize = sizeof(UTL_QueueCell) + UTL_GenericAddPadding(UTL_QueueDataSize(queue));
+    queue->cells    = malloc(queue->cellSize * queue->capacity);
+
+    for (size_t i = 0; i < (size_t) queue->capacity; i++)
+        atomic_init(&UTL_QueueCellAt(queue, i)->sequence, i);
+
+    atomic_init(&queue->pushPos, 0);
+    atomic_init(&queue->popPos,  0);
+
+    return (UTL_Queue*) queue;
+}
+
+
+/** free the memory associated with the given queue */
+void UTL_QueueDestroy(UTL_Queue *queue) {
+    free(((UTL_QueueImpl*) queue)->cells);
+    free(queue);
+}
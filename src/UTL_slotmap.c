@@ -0,0 +1,197 @@
+#include "UTL/UTL.h"
+
+
+/* capacity allocated on the first insert, slot maps are created without a buffer */
+#define UTL_SLOT_MAP_INITIAL_CAPACITY 16
+
+
+
+/* entry of the sparse index */
+typedef struct {
+    uint32_t generation;  // current generation, incremented whenever the object of the slot is removed
+    int      at;          // index of the object in the dense array, or the next free slot while free
+} UTL_SlotMapSlot;
+
+
+typedef struct {
+    const UTL_TypeInfo *dataType;  // see UTL_SlotMap
+    int                 count;     // see UTL_SlotMap
+
+    int              capacity;     // number of objects the dense array holds
+    uint8_t         *data;         // dense array of objects
+    uint32_t        *dataSlots;    // slot of each object of the dense array
+    UTL_SlotMapSlot *slots;        // sparse index
+    int              numSlots;     // number of slots ever used
+    int              freeSlot;     // first slot of the free list, -1 if there is none
+} UTL_SlotMapImpl;
+
+
+_STATIC_ASSERT(offsetof(UTL_SlotMap, dataType) == offsetof(UTL_SlotMapImpl, dataType));
+_STATIC_ASSERT(offsetof(UTL_SlotMap, count)    == offsetof(UTL_SlotMapImpl, count));
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define UTL_SlotMapAt(map, at) ((map)->data + (map)->dataType->size * (size_t)(at))
+
+
+static void UTL_SlotMapSetCapacity(UTL_SlotMapImpl *map, int capacity) {
+    map->data      = realloc(map->data,      map->dataType->size * capacity);
+    map->dataSlots = realloc(map->dataSlots, sizeof(uint32_t) * capacity);
+    map->slots     = realloc(map->slots,     sizeof(UTL_SlotMapSlot) * capacity);
+    map->capacity  = capacity;
+}
+
+
+/* the slot of a handle, NULL if the handle is not valid */
+static UTL_SlotMapSlot* UTL_SlotMapFind(UTL_SlotMapImpl *map, UTL_SlotHandle handle) {
+    if (handle.index >= (uint32_t) map->numSlots) return NULL;
+
+    // free slots already are in the generation of their next object, which has no handle yet
+    UTL_SlotMapSlot *slot = &map->slots[handle.index];
+    if (slot->generation != handle.generation) return NULL;
+    if (slot->at < 0 || slot->at >= map->count || map->dataSlots[slot->at] != handle.index) return NULL;
+    return slot;
+}
+
+
+/* end the current generation of a slot and put it on the free list */
+static void UTL_SlotMapFreeSlot(UTL_SlotMapImpl *map, uint32_t index) {
+    UTL_SlotMapSlot *slot = &map->slots[index];
+
+    // generation 0 is left out, so that the zero handle never becomes valid
+    if (++slot->generation == 0) slot->generation = 1;
+    slot->at = map->freeSlot;
+    map->freeSlot = (int) index;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** copy an object into the slot map, returns its handle */
+UTL_SlotHandle UTL_SlotMapInsert(UTL_SlotMap *map, void *obj) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    uint32_t index;
+
+    // reuse a free slot, or use a new one
+    if (impl->freeSlot >= 0) {
+        index = (uint32_t) impl->freeSlot;
+        impl->freeSlot = impl->slots[index].at;
+    }
+    else {
+        if (impl->numSlots == impl->capacity)
+            UTL_SlotMapSetCapacity(impl, impl->capacity ? impl->capacity * 2 : UTL_SLOT_MAP_INITIAL_CAPACITY);
+
+        index = (uint32_t) impl->numSlots++;
+        impl->slots[index].generation = 1;
+    }
+
+    impl->slots[index].at = impl->count;
+    impl->dataSlots[impl->count] = index;
+    memcpy(UTL_SlotMapAt(impl, impl->count), obj, impl->dataType->size);
+    impl->count++;
+
+    return (UTL_SlotHandle) { .index = index, .generation = impl->slots[index].generation };
+}
+
+
+/** the object with the given handle, NULL if it was removed */
+void* UTL_SlotMapGet(UTL_SlotMap *map, UTL_SlotHandle handle) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    UTL_SlotMapSlot *slot = UTL_SlotMapFind(impl, handle);
+
+    return slot ? UTL_SlotMapAt(impl, slot->at) : NULL;
+}
+
+
+/** is the object with the given handle in the slot map? */
+bool UTL_SlotMapContains(UTL_SlotMap *map, UTL_SlotHandle handle) {
+    return UTL_SlotMapFind((UTL_SlotMapImpl*) map, handle) != NULL;
+}
+
+
+/** remove the object with the given handle, moving the last object of the dense array into its place */
+bool UTL_SlotMapRemove(UTL_SlotMap *map, UTL_SlotHandle handle) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    UTL_SlotMapSlot *slot = UTL_SlotMapFind(impl, handle);
+    if (!slot) return false;
+
+    int at = slot->at, last = impl->count - 1;
+    if (at != last) {
+        memcpy(UTL_SlotMapAt(impl, at), UTL_SlotMapAt(impl, last), impl->dataType->size);
+        impl->dataSlots[at] = impl->dataSlots[last];
+        impl->slots[impl->dataSlots[at]].at = at;
+    }
+
+    impl->count--;
+    UTL_SlotMapFreeSlot(impl, handle.index);
+    return true;
+}
+
+
+/** remove all objects, invalidating all handles */
+void UTL_SlotMapClear(UTL_SlotMap *map) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+
+    for (int i = 0; i < impl->count; i++)
+        UTL_SlotMapFreeSlot(impl, impl->dataSlots[i]);
+
+    impl->count = 0;
+}
+
+
+/** make room for at least @capacity objects */
+void UTL_SlotMapReserve(UTL_SlotMap *map, int capacity) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    if (capacity > impl->capacity) UTL_SlotMapSetCapacity(impl, capacity);
+}
+
+
+/** span over all objects in the dense array */
+UTL_Span UTL_SlotMapGetSpan(UTL_SlotMap *map) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    return (UTL_Span) { .ptr = impl->data, .count = impl->count, .stride = impl->dataType->size };
+}
+
+
+/** handle of the object at index @at of the dense array */
+UTL_SlotHandle UTL_SlotMapHandleAt(UTL_SlotMap *map, int at) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    if (at < 0 || at >= impl->count) return (UTL_SlotHandle) { .index = 0, .generation = 0 };
+
+    uint32_t index = impl->dataSlots[at];
+    return (UTL_SlotHandle) { .index = index, .generation = impl->slots[index].generation };
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new slot map for objects of type @dataType */
+UTL_SlotMap* UTL_SlotMapCreate(const UTL_TypeInfo *dataType) {
+    UTL_SlotMapImpl *map = (UTL_SlotMapImpl*) malloc(sizeof(UTL_SlotMapImpl));
+
+    map->dataType  = dataType;
+    map->count     = 0;
+    map->capacity  = 0;
+    map->data      = NULL;
+    map->dataSlots = NULL;
+    map->slots     = NULL;
+    map->numSlots  = 0;
+    map->freeSlot  = -1;
+
+    return (UTL_SlotMap*) map;
+}
+
+
+/** free the memory associated with the given slot map */
+void UTL_SlotMapDestroy(UTL_SlotMap *map) {
+    UTL_SlotMapImpl *impl = (UTL_SlotMapImpl*) map;
+    free(impl->data);
+    free(impl->dataSlots);
+    free(impl->slots);
+    free(impl);
+}
@@ -0,0 +1,184 @@
+#include "UTL/UTL.h"
+
+
+/* alignment of each column, a cache line */
+#define UTL_SOA_LIST_COLUMN_ALIGNMENT 64
+
+/* capacity allocated on the first push, lists are created without columns */
+#define UTL_SOA_LIST_INITIAL_CAPACITY 16
+
+
+
+typedef struct {
+    int          numFields;   // see UTL_SoAList
+    size_t       recordSize;  // see UTL_SoAList
+    int          count;       // see UTL_SoAList
+
+    int           capacity;   // number of records the columns hold
+    UTL_SoAField *fields;     // the fields of a record
+    uint8_t     **columns;    // start of the column of each field
+    void         *memory;     // one allocation for all columns, unaligned
+} UTL_SoAListImpl;
+
+
+_STATIC_ASSERT(offsetof(UTL_SoAList, numFields)  == offsetof(UTL_SoAListImpl, numFields));
+_STATIC_ASSERT(offsetof(UTL_SoAList, recordSize) == offsetof(UTL_SoAListImpl, recordSize));
+_STATIC_ASSERT(offsetof(UTL_SoAList, count)      == offsetof(UTL_SoAListImpl, count));
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#define UTL_SoAListAt(list, field, at) ((list)->columns[field] + (list)->fields[field].size * (size_t)(at))
+
+
+static size_t UTL_SoAListAlignUp(size_t size) {
+    return (size + UTL_SOA_LIST_COLUMN_ALIGNMENT - 1) & ~(size_t)(UTL_SOA_LIST_COLUMN_ALIGNMENT - 1);
+}
+
+
+/* move the columns to one new allocation for @capacity records, each column starting on a cache line */
+static void UTL_SoAListSetCapacity(UTL_SoAListImpl *list, int capacity) {
+    size_t total = 0;
+    for (int f = 0; f < list->numFields; f++)
+        total += UTL_SoAListAlignUp(list->fields[f].size * capacity);
+
+    void    *memory = malloc(total + UTL_SOA_LIST_COLUMN_ALIGNMENT - 1);
+    uint8_t *column = (uint8_t*) UTL_SoAListAlignUp((uintptr_t) memory);
+
+    for (int f = 0; f < list->numFields; f++) {
+        if (list->count) memcpy(column, list->columns[f], list->fields[f].size * list->count);
+        list->columns[f] = column;
+        column += UTL_SoAListAlignUp(list->fields[f].size * capacity);
+    }
+
+    free(list->memory);
+    list->memory   = memory;
+    list->capacity = capacity;
+}
+
+
+/* copy the fields of @record into the columns at index @at */
+static void UTL_SoAListScatter(UTL_SoAListImpl *list, int at, const void *record) {
+    for (int f = 0; f < list->numFields; f++)
+        memcpy(UTL_SoAListAt(list, f, at), (const uint8_t*) record + list->fields[f].offset, list->fields[f].size);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** copy the record at index @at to @record. returns false if @at is out of bounds */
+bool UTL_SoAListGet(UTL_SoAList *list, int at, void *record) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (at < 0 || at >= impl->count) return false;
+
+    for (int f = 0; f < impl->numFields; f++)
+        memcpy((uint8_t*) record + impl->fields[f].offset, UTL_SoAListAt(impl, f, at), impl->fields[f].size);
+    return true;
+}
+
+
+/** overwrite the record at index @at with @record */
+void UTL_SoAListSet(UTL_SoAList *list, int at, const void *record) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (at < 0 || at >= impl->count) return;
+
+    UTL_SoAListScatter(impl, at, record);
+}
+
+
+/** pointer to field @field of the record at index @at, NULL if out of bounds */
+void* UTL_SoAListGetField(UTL_SoAList *list, int at, int field) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (at < 0 || at >= impl->count || field < 0 || field >= impl->numFields) return NULL;
+
+    return UTL_SoAListAt(impl, field, at);
+}
+
+
+/** append a new record to the back of the list */
+void UTL_SoAListPushBack(UTL_SoAList *list, const void *record) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+
+    if (impl->count == impl->capacity)
+        UTL_SoAListSetCapacity(impl, impl->capacity ? impl->capacity * 2 : UTL_SOA_LIST_INITIAL_CAPACITY);
+
+    UTL_SoAListScatter(impl, impl->count, record);
+    impl->count++;
+}
+
+
+/** remove the last record from the list */
+void UTL_SoAListPopBack(UTL_SoAList *list) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (impl->count) impl->count--;
+}
+
+
+/** remove the record at index @at by moving the last record into its place */
+void UTL_SoAListSwapRemove(UTL_SoAList *list, int at) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (at < 0 || at >= impl->count) return;
+
+    int last = impl->count - 1;
+    if (at != last) {
+        for (int f = 0; f < impl->numFields; f++)
+            memcpy(UTL_SoAListAt(impl, f, at), UTL_SoAListAt(impl, f, last), impl->fields[f].size);
+    }
+
+    impl->count--;
+}
+
+
+/** remove all records from the list, keeping its memory */
+void UTL_SoAListClear(UTL_SoAList *list) {
+    ((UTL_SoAListImpl*) list)->count = 0;
+}
+
+
+/** make room for at least @capacity records */
+void UTL_SoAListReserve(UTL_SoAList *list, int capacity) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (capacity > impl->capacity) UTL_SoAListSetCapacity(impl, capacity);
+}
+
+
+/** the column of field @field: a span over that field of all records */
+UTL_Span UTL_SoAListGetColumn(UTL_SoAList *list, int field) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    if (field < 0 || field >= impl->numFields) return (UTL_Span) { .ptr = NULL, .count = 0, .stride = 0 };
+
+    return (UTL_Span) { .ptr = impl->columns[field], .count = impl->count, .stride = impl->fields[field].size };
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** create a new structure of arrays list for records with the given fields */
+UTL_SoAList* UTL_SoAListCreate(const UTL_SoAField *fields, int numFields, size_t recordSize) {
+    UTL_SoAListImpl *list = (UTL_SoAListImpl*) malloc(sizeof(UTL_SoAListImpl));
+
+    list->numFields  = numFields;
+    list->recordSize = recordSize;
+    list->count      = 0;
+    list->capacity   = 0;
+    list->fields     = malloc(sizeof(UTL_SoAField) * numFields);
+    list->columns    = calloc(numFields, sizeof(uint8_t*));
+    list->memory     = NULL;
+
+    memcpy(list->fields, fields, sizeof(UTL_SoAField) * numFields);
+    return (UTL_SoAList*) list;
+}
+
+
+/** free the memory associated with the given list */
+void UTL_SoAListDestroy(UTL_SoAList *list) {
+    UTL_SoAListImpl *impl = (UTL_SoAListImpl*) list;
+    free(impl->memory);
+    free(impl->columns);
+    free(impl->fields);
+    free(impl);
+}
@@ -1,10 +1,22 @@
 #include "utl_string.h"
 #include "utl_list.h"
+#include "utl_soalist.h"
+#include "utl_queue.h"
+#include "utl_priorityqueue.h"
+#include "utl_bitset.h"
+#include "utl_slotmap.h"
+#include "utl_jobs.h"
 
 
 static TestClassEntry allTests[] = {
-    { "UTL_String", (TestFuncEntry*) &UTL_StringTests },
-    { "UTL_List",   (TestFuncEntry*) &UTL_ListTests },
+    { "UTL_String",        (TestFuncEntry*) &UTL_StringTests },
+    { "UTL_List",          (TestFuncEntry*) &UTL_ListTests },
+    { "UTL_SoAList",       (TestFuncEntry*) &UTL_SoAListTests },
+    { "UTL_Queue",         (TestFuncEntry*) &UTL_QueueTests },
+    { "UTL_PriorityQueue", (TestFuncEntry*) &UTL_PriorityQueueTests },
+    { "UTL_BitSet",        (TestFuncEntry*) &UTL_BitSetTests },
+    { "UTL_SlotMap",       (TestFuncEntry*) &UTL_SlotMapTests },
+    { "UTL_Jobs",          (TestFuncEntry*) &UTL_JobsTests },
     { NULL, NULL }
 };
 
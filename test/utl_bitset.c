@@ -0,0 +1,125 @@
+#include "utl_bitset.h"
+#include "UTL/UTL.h"
+
+
+/* does the bitset hold the same bits as @ref? */
+static bool sameBits(UTL_BitSet *set, const bool *ref, int numBits) {
+    if (set->numBits != numBits) return false;
+
+    int count = 0;
+    for (int i = 0; i < numBits; i++) {
+        if (UTL_BitSetTest(set, i) != ref[i]) return false;
+        count += ref[i];
+    }
+
+    return UTL_BitSetCount(set) == count;
+}
+
+
+static bool testBitSetBits(void) {
+    bool pass = true;
+    bool ref[1000] = { false };
+
+    UTL_BitSet *set = UTL_BitSetCreate(1000);
+    assertPass(sameBits(set, ref, 1000) && UTL_BitSetFindFirst(set) == -1);
+
+    srand(46);
+    for (int i = 0; i < 3000; i++) {
+        int bit = rand() % 1000;
+        if (rand() % 3) { UTL_BitSetSet(set, bit);   ref[bit] = true; }
+        else            { UTL_BitSetClear(set, bit); ref[bit] = false; }
+    }
+    assertPass(sameBits(set, ref, 1000));
+
+    // out of bounds
+    UTL_BitSetSet(set, 1000);
+    UTL_BitSetSet(set, -1);
+    assertPass(!UTL_BitSetTest(set, 1000) && !UTL_BitSetTest(set, -1) && sameBits(set, ref, 1000));
+
+    // iterate set bits
+    int next = 0, visited = 0;
+    for (int bit = UTL_BitSetFindFirst(set); bit >= 0; bit = UTL_BitSetFindNext(set, bit)) {
+        while (!ref[next]) next++;
+        assertPass(bit == next);
+        next++;
+        visited++;
+    }
+    assertPass(visited == UTL_BitSetCount(set));
+
+    // growing adds cleared bits, even where bits were set before shrinking
+    UTL_BitSetSetAll(set);
+    assertPass(UTL_BitSetCount(set) == 1000);
+    UTL_BitSetResize(set, 100);
+    assertPass(UTL_BitSetCount(set) == 100 && UTL_BitSetFindNext(set, 99) == -1);
+    UTL_BitSetResize(set, 5000);
+    assertPass(UTL_BitSetCount(set) == 100 && UTL_BitSetFindNext(set, 99) == -1);
+    UTL_BitSetSet(set, 4999);
+    assertPass(UTL_BitSetFindNext(set, 99) == 4999 && UTL_BitSetCount(set) == 101);
+
+    UTL_BitSetClearAll(set);
+    assertPass(UTL_BitSetCount(set) == 0 && UTL_BitSetFindFirst(set) == -1);
+
+    UTL_BitSetResize(set, 0);
+    assertPass(set->numBits == 0 && UTL_BitSetCount(set) == 0 && UTL_BitSetFindFirst(set) == -1);
+    UTL_BitSetSetAll(set);
+    assertPass(UTL_BitSetCount(set) == 0);
+
+    UTL_BitSetDestroy(set);
+    return pass;
+}
+
+
+static bool testBitSetOperations(void) {
+    bool pass = true;
+    int sizes[] = { 1, 63, 64, 65, 300, 1000, 4133 };
+
+    srand(46);
+    for (int a = 0; a < 7; a++) {
+        for (int b = 0; b < 7; b++) {
+            for (int op = 0; op < 4; op++) {
+                int numA = sizes[a], numB = sizes[b];
+                bool *refA = malloc(numA), *refB = malloc(numB);
+                UTL_BitSet *setA = UTL_BitSetCreate(numA), *setB = UTL_BitSetCreate(numB);
+
+                for (int i = 0; i < numA; i++) if ((refA[i] = rand() % 2)) UTL_BitSetSet(setA, i);
+                for (int i = 0; i < numB; i++) if ((refB[i] = rand() % 2)) UTL_BitSetSet(setB, i);
+
+                for (int i = 0; i < numA; i++) {
+                    bool other = i < numB ? refB[i] : false;
+                    switch (op) {
+                        case 0: refA[i] = refA[i] && other;  break;
+                        case 1: refA[i] = refA[i] || other;  break;
+                        case 2: refA[i] = refA[i] != other;  break;
+                        case 3: refA[i] = refA[i] && !other; break;
+                    }
+                }
+
+                switch (op) {
+                    case 0: UTL_BitSetAnd(setA, setB);    break;
+                    case 1: UTL_BitSetOr(setA, setB);     break;
+                    case 2: UTL_BitSetXor(setA, setB);    break;
+                    case 3: UTL_BitSetAndNot(setA, setB); break;
+                }
+
+                assertPass(sameBits(setA, refA, numA));
+
+                UTL_BitSetDestroy(setA);
+                UTL_BitSetDestroy(setB);
+                free(refA);
+                free(refB);
+            }
+        }
+    }
+
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TestFuncEntry UTL_BitSetTests[] = {
+    { "bits",       &testBitSetBits },
+    { "operations", &testBitSetOperations },
+    { NULL, NULL }
+};
@@ -0,0 +1,3 @@
+#include "testing.h"
+
+extern TestFuncEntry UTL_BitSetTests[];
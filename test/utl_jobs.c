@@ -0,0 +1,156 @@
+#include "utl_jobs.h"
+#include "UTL/UTL.h"
+#include <stdatomic.h>
+
+
+typedef struct {
+    atomic_int  counter;    // number of jobs run so far
+    int         order[8];   // value of @counter when each job of a test ran
+    UTL_Jobs   *jobs;
+    UTL_Job    *parent;
+} JobsTestData;
+
+
+static void jobsCount(void *aux) {
+    atomic_fetch_add(&((JobsTestData*) aux)->counter, 1);
+}
+
+
+#define JOBS_RECORD_FUNC(i) \
+    static void jobsRecord##i(void *aux) { \
+        JobsTestData *data = aux; \
+        data->order[i] = atomic_fetch_add(&data->counter, 1); \
+    }
+
+JOBS_RECORD_FUNC(0)
+JOBS_RECORD_FUNC(1)
+JOBS_RECORD_FUNC(2)
+JOBS_RECORD_FUNC(3)
+
+
+/* spawns children of the job running it, which only finishes after them */
+static void jobsSpawn(void *aux) {
+    JobsTestData *data = aux;
+    for (int i = 0; i < 100; i++)
+        UTL_JobRelease(UTL_JobsRun(data->jobs, &jobsCount, data, data->parent, NULL, 0));
+}
+
+
+static bool testJobsRun(void) {
+    bool pass = true;
+    UTL_Jobs *jobs = UTL_JobsCreate(4);
+    assertPass(jobs->numWorkers == 4);
+
+    // many independent jobs, more than fit into the queue of a thread which is no worker
+    JobsTestData data = { .jobs = jobs };
+    atomic_init(&data.counter, 0);
+    UTL_Job *handles[2000];
+    for (int i = 0; i < 2000; i++) handles[i] = UTL_JobsRun(jobs, &jobsCount, &data, NULL, NULL, 0);
+    for (int i = 0; i < 2000; i++) UTL_JobsWait(jobs, handles[i]);
+    assertPass(atomic_load(&data.counter) == 2000);
+
+    // dependencies: 0 -> 1, 0 -> 2, (1, 2) -> 3
+    for (int round = 0; round < 100; round++) {
+        atomic_store(&data.counter, 0);
+        UTL_Job *job0 = UTL_JobsRun(jobs, &jobsRecord0, &data, NULL, NULL, 0);
+        UTL_Job *job1 = UTL_JobsRun(jobs, &jobsRecord1, &data, NULL, &job0, 1);
+        UTL_Job *job2 = UTL_JobsRun(jobs, &jobsRecord2, &data, NULL, &job0, 1);
+        UTL_Job *deps[3] = { job1, NULL, job2 };
+        UTL_Job *job3 = UTL_JobsRun(jobs, &jobsRecord3, &data, NULL, deps, 3);
+
+        UTL_JobsWait(jobs, job3);
+        assertPass(UTL_JobIsDone(job0) && UTL_JobIsDone(job1) && UTL_JobIsDone(job2));
+        assertPass(data.order[0] == 0 && data.order[3] == 3);
+        assertPass(data.order[1] > 0 && data.order[2] > 0 && data.order[1] < 3 && data.order[2] < 3);
+        UTL_JobRelease(job0);
+        UTL_JobRelease(job1);
+        UTL_JobRelease(job2);
+    }
+
+    // children: waiting for the parent waits for the jobs it spawned
+    atomic_store(&data.counter, 0);
+    UTL_Job *parent = UTL_JobsRun(jobs, NULL, NULL, NULL, NULL, 0);
+    data.parent = UTL_JobsRun(jobs, &jobsSpawn, &data, parent, NULL, 0);
+    UTL_JobsWait(jobs, parent);
+    assertPass(atomic_load(&data.counter) == 100);
+    assertPass(UTL_JobIsDone(data.parent));
+    UTL_JobRelease(data.parent);
+
+    UTL_JobsDestroy(jobs);
+    return pass;
+}
+
+
+typedef struct {
+    char       *visits;  // number of times each index was visited
+    atomic_int  ranges;  // number of ranges run
+    int         grainSize;
+    bool        inGrain; // all ranges no larger than @grainSize
+    UTL_Jobs   *jobs;
+} JobsForData;
+
+
+static void jobsVisit(void *aux, int first, int last) {
+    JobsForData *data = aux;
+    if (last - first > data->grainSize) data->inGrain = false;
+    for (int i = first; i < last; i++) data->visits[i]++;
+    atomic_fetch_add(&data->ranges, 1);
+}
+
+
+/* a parallel for running within a job of another parallel for */
+static void jobsVisitNested(void *aux, int first, int last) {
+    JobsForData *data = aux;
+    for (int i = first; i < last; i++) {
+        JobsForData inner = { .visits = calloc(100, 1), .grainSize = 7, .inGrain = true };
+        atomic_init(&inner.ranges, 0);
+        UTL_JobsParallelFor(data->jobs, 100, &jobsVisit, &inner, 7);
+
+        bool all = true;
+        for (int j = 0; j < 100; j++) all &= inner.visits[j] == 1;
+        if (all && inner.inGrain) data->visits[i]++;
+        free(inner.visits);
+    }
+}
+
+
+static bool testJobsParallelFor(void) {
+    bool pass = true;
+    UTL_Jobs *jobs = UTL_JobsCreate(3);
+
+    int counts[]     = { 0, 1, 5, 1000, 100000 };
+    int grainSizes[] = { 0, 1, 64 };
+
+    for (int c = 0; c < 5; c++) {
+        for (int g = 0; g < 3; g++) {
+            JobsForData data = { .visits = calloc(counts[c] + 1, 1), .inGrain = true };
+            data.grainSize = grainSizes[g] > 0 ? grainSizes[g] : counts[c];
+            atomic_init(&data.ranges, 0);
+
+            UTL_JobsParallelFor(jobs, counts[c], &jobsVisit, &data, grainSizes[g]);
+
+            for (int i = 0; i < counts[c]; i++) assertPass(data.visits[i] == 1);
+            assertPass(data.inGrain);
+            assertPass(counts[c] == 0 ? atomic_load(&data.ranges) == 0 : atomic_load(&data.ranges) > 0);
+            free(data.visits);
+        }
+    }
+
+    JobsForData data = { .visits = calloc(50, 1), .jobs = jobs };
+    UTL_JobsParallelFor(jobs, 50, &jobsVisitNested, &data, 1);
+    for (int i = 0; i < 50; i++) assertPass(data.visits[i] == 1);
+    free(data.visits);
+
+    UTL_JobsDestroy(jobs);
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TestFuncEntry UTL_JobsTests[] = {
+    { "run",         &testJobsRun },
+    { "parallelFor", &testJobsParallelFor },
+    { NULL, NULL }
+};
@@ -1,5 +1,1416 @@
 #include "utl_list.h"
+#include "UTL/UTL.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+
+#define IntCmp(a, b) (((a) > (b)) - ((a) < (b)))
+
+UTL_LIST_DEFINE(IntList, int)
+UTL_LIST_DEFINE_CMP(IntList, int, IntCmp)
+
+
+static bool testTypedListBasics(void) {
+    bool pass = true;
+    IntList *list = IntList_Create();
+
+    for (int i = 0; i < 100; i++)
+        IntList_PushBack(list, i);
+    assertPass(list->count == 100);
+    assertPass(IntList_Get(list, 42) == 42);
+    assertPass(IntList_GetFront(list) == 0);
+    assertPass(IntList_GetBack(list) == 99);
+    assertPass(IntList_GetPtr(list, 100) == NULL);
+
+    IntList_PushFront(list, -1);
+    IntList_Insert(list, 50, 1000);
+    assertPass(IntList_Get(list, 0) == -1);
+    assertPass(IntList_Get(list, 50) == 1000);
+    assertPass(IntList_Get(list, 51) == 49);
+    assertPass(IntList_FindFirst(list, 1000, 0) == 50);
+    assertPass(IntList_Contains(list, 99));
+    assertPass(!IntList_Contains(list, 100));
+
+    IntList_Remove(list, 50);
+    IntList_PopFront(list);
+    IntList_PopBack(list);
+    assertPass(list->count == 99);
+
+    int i = 0;
+    for (IntListIter iter = IntList_GetIteratorFront(list); IntList_IterIsValid(&iter); IntList_IterNext(&iter))
+        assertPass(IntList_IterGet(&iter) == i++);
+    assertPass(i == 99);
+
+    IntList_Destroy(list);
+    return pass;
+}
+
+
+static bool testTypedListSort(void) {
+    bool pass = true;
+    IntList *list = IntList_Create();
+
+    srand(1);
+    for (int i = 0; i < 10000; i++)
+        IntList_PushBack(list, rand() % 1000);
+    IntList_Sort(list);
+    assertPass(list->count == 10000);
+    assertPass(IntList_IsSorted(list));
+
+    // already sorted and reversed input
+    for (int i = 0; i < list->count; i++)
+        IntList_Set(list, i, list->count - i);
+    IntList_Sort(list);
+    assertPass(IntList_IsSorted(list));
+    assertPass(IntList_GetFront(list) == 1);
+
+    IntList_Destroy(list);
+    return pass;
+}
+
+
+typedef struct {
+    int key;
+    int seq;
+} KeySeq;
+
+static int compareKeySeq(const void *p1, const void *p2) {
+    const KeySeq *k1 = p1;
+    const KeySeq *k2 = p2;
+    return (k1->key > k2->key) - (k1->key < k2->key);
+}
+
+static const UTL_TypeInfo typeInfoKeySeq = {
+    .size    = sizeof(KeySeq),
+    .cmpFunc = &compareKeySeq,
+    .name    = "KeySeq"
+};
+
+
+static bool testListSortPrimitives(void) {
+    bool pass = true;
+    UTL_List *ints   = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt,   false);
+    UTL_List *floats = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoFloat, false);
+    UTL_List *chars  = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoChar,  false);
+
+    srand(2);
+    long long sum = 0;
+    for (int i = 0; i < 20000; i++) {
+        int   n = rand() - RAND_MAX / 2;
+        float f = (float)n / 7.0f;
+        char  c = (char)(rand() % 200 - 100);
+        sum += n;
+        UTL_ListPushBack(ints,   &n);
+        UTL_ListPushBack(floats, &f);
+        UTL_ListPushBack(chars,  &c);
+    }
+
+    UTL_ListSort(ints);
+    UTL_ListSort(floats);
+    UTL_ListSort(chars);
+    assertPass(UTL_ListIsSorted(ints));
+    assertPass(UTL_ListIsSorted(floats));
+    assertPass(UTL_ListIsSorted(chars));
+
+    for (int i = 0; i < ints->count; i++) sum -= *(int*)UTL_ListGet(ints, i);
+    assertPass(sum == 0);
+
+    UTL_ListDestroy(ints);
+    UTL_ListDestroy(floats);
+    UTL_ListDestroy(chars);
+    return pass;
+}
+
+
+static bool testListSortStable(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &typeInfoKeySeq, false);
+
+        srand(3);
+        for (int i = 0; i < 5000; i++) {
+            KeySeq k = { .key = rand() % 50, .seq = i };
+            UTL_ListPushBack(list, &k);
+        }
+
+        UTL_ListSortStable(list);
+        assertPass(list->count == 5000);
+        assertPass(UTL_ListIsSorted(list));
+
+        for (int i = 1; i < list->count; i++) {
+            KeySeq *k1 = UTL_ListGet(list, i-1);
+            KeySeq *k2 = UTL_ListGet(list, i);
+            assertPass(k1->key < k2->key || k1->seq < k2->seq);
+        }
+
+        // unstable sort, many duplicates and presorted input
+        UTL_ListSort(list);
+        assertPass(UTL_ListIsSorted(list));
+        UTL_ListSort(list);
+        assertPass(UTL_ListIsSorted(list));
+
+        UTL_ListDestroy(list);
+    }
+
+    return pass;
+}
+
+
+static bool testListSortByRef(void) {
+    bool pass = true;
+    const char *words[] = { "pear", "apple", "fig", "banana", "cherry", "kiwi", "date", "grape" };
+    UTL_List *lists[] = {
+        UTL_ListCreate(UTL_ARRAY_LIST,  &UTL_TypeInfoString, true),
+        UTL_ListCreate(UTL_LINKED_LIST, &UTL_TypeInfoString, true)
+    };
+
+    for (int l = 0; l < 2; l++) {
+        for (int i = 0; i < 400; i++)
+            UTL_ListPushBack(lists[l], UTL_StringCreate(words[(i * 7) % 8], -1));
+
+        assertPass(!UTL_ListIsSorted(lists[l]));
+        UTL_ListSort(lists[l]);
+        assertPass(UTL_ListIsSorted(lists[l]));
+        assertPass(strcmp(((UTL_String*)UTL_ListGetFront(lists[l]))->buf, "apple") == 0);
+
+        for (int i = 0; i < lists[l]->count; i++)
+            UTL_StringDestroy(UTL_ListGet(lists[l], i));
+        UTL_ListDestroy(lists[l]);
+    }
+
+    return pass;
+}
+
+
+static bool testListSortParallel(void) {
+    bool pass = true;
+    UTL_List *ints = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+    UTL_List *keys = UTL_ListCreate(UTL_ARRAY_LIST, &typeInfoKeySeq, false);
+
+    srand(4);
+    for (int i = 0; i < 300000; i++) {
+        int n = rand() - RAND_MAX / 2;
+        KeySeq k = { .key = rand() % 1000, .seq = i };
+        UTL_ListPushBack(ints, &n);
+        UTL_ListPushBack(keys, &k);
+    }
+
+    UTL_ListSortParallel(ints, 4);
+    UTL_ListSortParallel(keys, 3);
+    assertPass(ints->count == 300000);
+    assertPass(keys->count == 300000);
+    assertPass(UTL_ListIsSorted(ints));
+    assertPass(UTL_ListIsSorted(keys));
+
+    UTL_ListDestroy(ints);
+    UTL_ListDestroy(keys);
+    return pass;
+}
+
+
+/* check that an int list holds exactly the given values, using both indexed access and iterators */
+static bool listEquals(UTL_List *list, const int *values, int count) {
+    if (list->count != count) return false;
+
+    for (int i = 0; i < count; i++)
+        if (*(int*)UTL_ListGet(list, i) != values[i]) return false;
+
+    int i = 0;
+    for (UTL_ListIter iter = UTL_ListGetIteratorFront(list); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter))
+        if (*(int*)UTL_ListIterGet(&iter) != values[i++]) return false;
+
+    return i == count;
+}
+
+
+static bool testListInsertRemove(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+
+        for (int i = 1; i <= 5; i++) UTL_ListPushBack(list, &i);
+        int zero = 0, ten = 10, twenty = 20;
+        UTL_ListPushFront(list, &zero);
+        UTL_ListInsert(list, 3, &ten);
+        UTL_ListInsert(list, 100, &twenty);
+        assertPass(listEquals(list, (int[]) { 0, 1, 2, 10, 3, 4, 5, 20 }, 8));
+        assertPass(*(int*)UTL_ListGetBack(list) == 20);
+
+        UTL_ListRemove(list, 3);
+        UTL_ListPopFront(list);
+        UTL_ListPopBack(list);
+        UTL_ListSet(list, 0, &ten);
+        assertPass(listEquals(list, (int[]) { 10, 2, 3, 4, 5 }, 5));
+
+        // remove odd numbers and insert a copy in front of even ones
+        UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+        while (UTL_ListIterIsValid(&iter)) {
+            int i = *(int*)UTL_ListIterGet(&iter);
+            if (i % 2) {
+                UTL_ListIterRemove(&iter);
+            }
+            else {
+                UTL_ListIterInsert(&iter, &i);
+                UTL_ListIterNext(&iter);
+            }
+        }
+        assertPass(listEquals(list, (int[]) { 10, 10, 2, 2, 4, 4 }, 6));
+
+        while (list->count) UTL_ListPopBack(list);
+        assertPass(UTL_ListGetFront(list) == NULL);
+
+        UTL_ListDestroy(list);
+    }
+
+    return pass;
+}
+
+
+static bool testListNodePool(void) {
+    bool pass = true;
+    UTL_ListNodePool *pool = UTL_ListNodePoolCreate(&UTL_TypeInfoInt, false);
+
+    UTL_List *list1 = UTL_ListCreateWithPool(&UTL_TypeInfoInt, false, pool);
+    UTL_List *list2 = UTL_ListCreateWithPool(&UTL_TypeInfoInt, false, pool);
+    assertPass(UTL_ListCreateWithPool(&(UTL_TypeInfo) { .size = 64 }, false, pool) == NULL);
+    UTL_ListNodePoolDestroy(pool); // the lists keep the pool alive
+
+    for (int i = 0; i < 1000; i++) {
+        UTL_ListPushBack(list1, &i);
+        UTL_ListPushFront(list2, &i);
+    }
+    for (int i = 0; i < 500; i++)
+        UTL_ListPopFront(list1);
+    for (int i = 0; i < 500; i++)
+        UTL_ListPushBack(list2, &i);
+
+    assertPass(list1->count == 500);
+    assertPass(list2->count == 1500);
+    assertPass(*(int*)UTL_ListGetFront(list1) == 500);
+    assertPass(*(int*)UTL_ListGetFront(list2) == 999);
+    assertPass(*(int*)UTL_ListGetBack(list2) == 499);
+
+    UTL_ListDestroy(list1);
+    for (int i = 0; i < 100; i++)
+        UTL_ListPushBack(list2, &i);
+    assertPass(list2->count == 1600);
+    UTL_ListDestroy(list2);
+
+    return pass;
+}
+
+
+/* apply the same random edits to a list and an IntList and compare them */
+static bool randomEdits(UTL_List *list, int numEdits) {
+    IntList *reference = IntList_Create();
+    bool pass = true;
+
+    for (int i = 0; i < list->count; i++)
+        IntList_PushBack(reference, *(int*)UTL_ListGet(list, i));
+
+    for (int e = 0; e < numEdits && pass; e++) {
+        int op = rand() % 8;
+        int at = reference->count ? rand() % reference->count : 0;
+        int value = rand();
+
+        if (op < 3) {
+            UTL_ListPushBack(list, &value);
+            IntList_PushBack(reference, value);
+        }
+        else if (op < 5) {
+            UTL_ListInsert(list, at, &value);
+            IntList_Insert(reference, at, value);
+        }
+        else if (op < 7 && reference->count) {
+            UTL_ListRemove(list, at);
+            IntList_Remove(reference, at);
+        }
+        else if (reference->count) {
+            UTL_ListSet(list, at, &value);
+            IntList_Set(reference, at, value);
+        }
+    }
+
+    pass = pass && listEquals(list, reference->data, reference->count);
+
+    // walk backwards as well
+    UTL_ListIter iter = UTL_ListGetIteratorBack(list);
+    for (int i = reference->count - 1; i >= 0 && pass; i--) {
+        pass = UTL_ListIterIsValid(&iter) && *(int*)UTL_ListIterGet(&iter) == reference->data[i];
+        UTL_ListIterPrev(&iter);
+    }
+
+    IntList_Destroy(reference);
+    return pass;
+}
+
+
+static bool testUnrolledList(void) {
+    bool pass = true;
+    UTL_List *list = UTL_ListCreate(UTL_UNROLLED_LIST, &UTL_TypeInfoInt, false);
+
+    srand(5);
+    assertPass(randomEdits(list, 20000));
+
+    // shrink back down to exercise merging of chunks
+    while (list->count > 10) UTL_ListRemove(list, rand() % list->count);
+    assertPass(randomEdits(list, 2000));
+
+    UTL_ListSort(list);
+    assertPass(UTL_ListIsSorted(list));
+
+    // iterator edits across chunk boundaries
+    while (list->count) UTL_ListPopBack(list);
+    for (int i = 0; i < 5000; i++) UTL_ListPushBack(list, &i);
+
+    UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+    while (UTL_ListIterIsValid(&iter)) {
+        int i = *(int*)UTL_ListIterGet(&iter);
+        if (i % 3) {
+            UTL_ListIterRemove(&iter);
+        }
+        else {
+            UTL_ListIterInsert(&iter, &i);
+            UTL_ListIterNext(&iter);
+        }
+    }
+    assertPass(list->count == 2 * 1667);
+    for (int i = 0; i < list->count; i++)
+        assertPass(*(int*)UTL_ListGet(list, i) == (i / 2) * 3);
+
+    UTL_ListDestroy(list);
+    return pass;
+}
+
+
+static bool testDequeList(void) {
+    bool pass = true;
+    UTL_List *list = UTL_ListCreate(UTL_DEQUE_LIST, &UTL_TypeInfoInt, false);
+
+    // pushing at both ends wraps around the buffer and grows it
+    for (int i = 0; i < 200; i++) {
+        int front = -i - 1;
+        UTL_ListPushBack(list, &i);
+        UTL_ListPushFront(list, &front);
+    }
+    assertPass(list->count == 400);
+    for (int i = 0; i < list->count; i++)
+        assertPass(*(int*)UTL_ListGet(list, i) == i - 200);
+
+    // popping from both ends
+    for (int i = 0; i < 150; i++) {
+        UTL_ListPopFront(list);
+        UTL_ListPopBack(list);
+    }
+    assertPass(list->count == 100);
+    assertPass(*(int*)UTL_ListGetFront(list) == -50);
+    assertPass(*(int*)UTL_ListGetBack(list)  == 49);
+
+    srand(7);
+    assertPass(randomEdits(list, 20000));
+
+    // sorting a wrapped buffer
+    while (list->count) UTL_ListPopBack(list);
+    for (int i = 0; i < 40; i++) {
+        int value = rand() % 100;
+        UTL_ListPushFront(list, &value);
+        UTL_ListPushBack(list, &value);
+    }
+    UTL_ListSort(list);
+    assertPass(UTL_ListIsSorted(list));
+
+    UTL_ListDestroy(list);
+    return pass;
+}
+
+
+static bool testTreeList(void) {
+    bool pass = true;
+    UTL_List *list = UTL_ListCreate(UTL_TREE_LIST, &UTL_TypeInfoInt, false);
+
+    // enough objects for two levels of inner nodes
+    for (int i = 0; i < 300000; i++) UTL_ListPushBack(list, &i);
+    for (int i = 0; i < list->count; i += 997)
+        assertPass(*(int*)UTL_ListGet(list, i) == i);
+
+    srand(11);
+    assertPass(randomEdits(list, 5000));
+
+    // shrink back down to exercise merging of leaves and inner nodes
+    while (list->count > 10) UTL_ListRemove(list, rand() % list->count);
+    assertPass(randomEdits(list, 20000));
+
+    UTL_ListSort(list);
+    assertPass(UTL_ListIsSorted(list));
+
+    // iterator edits across leaf boundaries
+    while (list->count) UTL_ListPopFront(list);
+    for (int i = 0; i < 5000; i++) UTL_ListPushBack(list, &i);
+
+    UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+    while (UTL_ListIterIsValid(&iter)) {
+        int i = *(int*)UTL_ListIterGet(&iter);
+        if (i % 3) {
+            UTL_ListIterRemove(&iter);
+        }
+        else {
+            UTL_ListIterInsert(&iter, &i);
+            UTL_ListIterNext(&iter);
+        }
+    }
+    assertPass(list->count == 2 * 1667);
+    for (int i = 0; i < list->count; i++)
+        assertPass(*(int*)UTL_ListGet(list, i) == (i / 2) * 3);
+    UTL_ListDestroy(list);
+
+    // objects without a size still get full leaves
+    static const UTL_TypeInfo typeInfoEmpty = { .size = 0, .name = "Empty" };
+    list = UTL_ListCreate(UTL_TREE_LIST, &typeInfoEmpty, false);
+    for (int i = 0; i < 1000; i++) UTL_ListPushBack(list, &i);
+    assertPass(list->count == 1000);
+
+    UTL_ListDestroy(list);
+    return pass;
+}
+
+
+static bool testListBulk(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+
+    int values[3000];
+    for (int i = 0; i < 3000; i++) values[i] = i;
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+        IntList *reference = IntList_Create();
+
+        UTL_ListReserve(list, 100);
+        UTL_ListPushBackN(list, values, 3000);
+        for (int i = 0; i < 3000; i++) IntList_PushBack(reference, i);
+
+        // ranges inside the list, at its ends and clipped at its end
+        int at[] = { 1000, 0, 2500, 2990 };
+        for (int r = 0; r < 4; r++) {
+            UTL_ListInsertRange(list, at[r], values + 7, 400);
+            for (int i = 0; i < 400; i++) IntList_Insert(reference, at[r] + i, 7 + i);
+
+            UTL_ListRemoveRange(list, at[r] / 2, 300);
+            for (int i = 0; i < 300 && at[r] / 2 < reference->count; i++) IntList_Remove(reference, at[r] / 2);
+        }
+        UTL_ListRemoveRange(list, reference->count - 10, 100);
+        for (int i = 0; i < 10; i++) IntList_PopBack(reference);
+        assertPass(listEquals(list, reference->data, reference->count));
+
+        // appending to itself doubles the list
+        UTL_ListAppendList(list, list);
+        for (int i = 0, n = reference->count; i < n; i++) IntList_PushBack(reference, reference->data[i]);
+        assertPass(listEquals(list, reference->data, reference->count));
+
+        // appending to a list of another type
+        UTL_List *array = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+        UTL_ListAppendList(array, list);
+        assertPass(listEquals(array, reference->data, reference->count));
+
+        UTL_ListRemoveRange(list, 0, list->count);
+        UTL_ListShrinkToFit(list);
+        assertPass(list->count == 0 && UTL_ListGetFront(list) == NULL);
+        UTL_ListAppendList(list, array);
+        assertPass(listEquals(list, reference->data, reference->count));
+
+        UTL_ListDestroy(array);
+        UTL_ListDestroy(list);
+        IntList_Destroy(reference);
+    }
+
+    // lists storing by reference take object pointers
+    UTL_List *list = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, true);
+    int *pointers[] = { &values[5], &values[6], &values[7] };
+    UTL_ListPushBackN(list, pointers, 3);
+    UTL_ListInsertRange(list, 1, pointers, 2);
+    assertPass(listEquals(list, (int[]) { 5, 5, 6, 6, 7 }, 5));
+    assertPass(UTL_ListGet(list, 1) == &values[5]);
+    UTL_ListShrinkToFit(list);
+    assertPass(listEquals(list, (int[]) { 5, 5, 6, 6, 7 }, 5));
+    UTL_ListDestroy(list);
+
+    return pass;
+}
+
+
+static bool isMultipleOf(void *aux, void *obj) {
+    return *(int*)obj % *(int*)aux == 0;
+}
+
+
+static bool testListRemoveIf(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+        IntList *reference = IntList_Create();
+
+        srand(13);
+        for (int i = 0; i < 20000; i++) {
+            int value = rand() % 1000;
+            UTL_ListPushBack(list, &value);
+            if (value % 3) IntList_PushBack(reference, value);
+        }
+
+        int three = 3;
+        assertPass(UTL_ListRemoveIf(list, &isMultipleOf, &three) == 20000 - reference->count);
+        assertPass(listEquals(list, reference->data, reference->count));
+
+        // the list still takes edits after compacting
+        assertPass(randomEdits(list, 2000));
+
+        int two = 2;
+        int count = list->count;
+        int removed = UTL_ListRetainIf(list, &isMultipleOf, &two);
+        assertPass(list->count == count - removed);
+        for (int i = 0; i < list->count; i++) assertPass(*(int*)UTL_ListGet(list, i) % 2 == 0);
+
+        UTL_ListSort(list);
+        UTL_ListUnique(list);
+        for (int i = 1; i < list->count; i++)
+            assertPass(*(int*)UTL_ListGet(list, i - 1) < *(int*)UTL_ListGet(list, i));
+
+        int one = 1;
+        UTL_ListRemoveIf(list, &isMultipleOf, &one);
+        assertPass(list->count == 0 && UTL_ListGetBack(list) == NULL);
+        assertPass(randomEdits(list, 100));
+
+        UTL_ListDestroy(list);
+        IntList_Destroy(reference);
+    }
+
+    return pass;
+}
+
+
+static bool testListFind(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+
+        for (int i = 0; i < 100; i++) {
+            int value = i % 40;
+            UTL_ListPushBack(list, &value);
+        }
+
+        int value = 17, missing = 40;
+        assertPass(UTL_ListFindFirst(list, &value, 0)    == 17);
+        assertPass(UTL_ListFindFirst(list, &value, 18)   == 57);
+        assertPass(UTL_ListFindFirst(list, &value, 98)   == -1);
+        assertPass(UTL_ListFindLast(list, &value, 1000)  == 97);
+        assertPass(UTL_ListFindLast(list, &value, 56)    == 17);
+        assertPass(UTL_ListFindLast(list, &value, 16)    == -1);
+        assertPass(UTL_ListContains(list, &value));
+        assertPass(!UTL_ListContains(list, &missing));
+
+        UTL_ListDestroy(list);
+    }
+
+    // the vectorized searches around block boundaries
+    UTL_List *ints   = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt,   false);
+    UTL_List *floats = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoFloat, false);
+    UTL_List *chars  = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoChar,  false);
+    for (int i = 0; i < 100; i++) {
+        int   zeroInt   = 0;
+        float zeroFloat = 0.0f;
+        char  zeroChar  = 0;
+        UTL_ListPushBack(ints,   &zeroInt);
+        UTL_ListPushBack(floats, &zeroFloat);
+        UTL_ListPushBack(chars,  &zeroChar);
+    }
+    for (int at = 0; at < 100; at++) {
+        int   needleInt   = 1;
+        float needleFloat = 1.0f;
+        char  needleChar  = 1;
+        UTL_ListSet(ints,   at, &needleInt);
+        UTL_ListSet(floats, at, &needleFloat);
+        UTL_ListSet(chars,  at, &needleChar);
+
+        for (int offset = 0; offset < 100; offset += 7) {
+            int first = offset <= at ? at : -1;
+            int last  = offset >= at ? at : -1;
+            assertPass(UTL_ListFindFirst(ints,   &needleInt,   offset) == first);
+            assertPass(UTL_ListFindFirst(floats, &needleFloat, offset) == first);
+            assertPass(UTL_ListFindFirst(chars,  &needleChar,  offset) == first);
+            assertPass(UTL_ListFindLast(ints,    &needleInt,   offset) == last);
+            assertPass(UTL_ListFindLast(floats,  &needleFloat, offset) == last);
+            assertPass(UTL_ListFindLast(chars,   &needleChar,  offset) == last);
+        }
+
+        int   zeroInt   = 0;
+        float zeroFloat = 0.0f;
+        char  zeroChar  = 0;
+        UTL_ListSet(ints,   at, &zeroInt);
+        UTL_ListSet(floats, at, &zeroFloat);
+        UTL_ListSet(chars,  at, &zeroChar);
+    }
+
+    // floats are found as their compare function sees them: -0 equals 0, and NaN equals everything
+    float negZero = -0.0f, nan = NAN;
+    assertPass(UTL_ListFindFirst(floats, &negZero, 0) == 0);
+    UTL_ListSet(floats, 60, &nan);
+    float one = 1.0f;
+    assertPass(UTL_ListFindFirst(floats, &one, 0) == 60);
+    assertPass(UTL_ListFindLast(floats, &nan, 1000) == 99);
+
+    UTL_ListDestroy(ints);
+    UTL_ListDestroy(floats);
+    UTL_ListDestroy(chars);
+
+    // objects stored by reference without compare function are compared by address
+    int a = 1, b = 1;
+    UTL_List *list = UTL_ListCreate(UTL_ARRAY_LIST, &(UTL_TypeInfo) { .size = sizeof(int) }, true);
+    UTL_ListPushBack(list, &a);
+    assertPass(UTL_ListContains(list, &a));
+    assertPass(!UTL_ListContains(list, &b));
+    UTL_ListDestroy(list);
+
+    return pass;
+}
+
+
+static bool testListReductions(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *ints   = UTL_ListCreate(types[t], &UTL_TypeInfoInt,   false);
+        UTL_List *floats = UTL_ListCreate(types[t], &UTL_TypeInfoFloat, false);
+
+        // sizes that are no multiple of any vector width
+        srand(17);
+        int64_t intSum = 0, intDot = 0;
+        double floatSum = 0.0, floatDot = 0.0;
+        int intMin = INT_MAX, intMax = INT_MIN;
+        for (int i = 0; i < 10007; i++) {
+            int   intValue   = rand() % 2000001 - 1000000;
+            float floatValue = (float) (rand() % 2001 - 1000) / 8;
+            UTL_ListPushBack(ints,   &intValue);
+            UTL_ListPushBack(floats, &floatValue);
+
+            intSum   += intValue;
+            intDot   += (int64_t) intValue * intValue;
+            floatSum += floatValue;
+            floatDot += (double) floatValue * floatValue;
+            if (intValue < intMin) intMin = intValue;
+            if (intValue > intMax) intMax = intValue;
+        }
+
+        // the floats are multiples of 1/8 small enough to be summed exactly
+        assertPass(UTL_ListSum(ints) == (double) intSum);
+        assertPass(UTL_ListSum(floats) == floatSum);
+        assertPass(UTL_ListSumPairwise(floats) == floatSum);
+        assertPass(UTL_ListDot(ints, ints) == (double) intDot);
+        assertPass(fabs(UTL_ListDot(floats, floats) - floatDot) <= 1e-5 * floatDot);
+
+        int lo, hi;
+        assertPass(UTL_ListMinMax(ints, &lo, &hi) && lo == intMin && hi == intMax);
+
+        float nan = NAN, big = 5000.0f, floatLo, floatHi;
+        UTL_ListSet(floats, 0,    &nan);
+        UTL_ListSet(floats, 5000, &big);
+        UTL_ListSet(floats, 9000, &nan);
+        assertPass(UTL_ListMax(floats, &floatHi) && floatHi == 5000.0f);
+        assertPass(UTL_ListMin(floats, &floatLo) && floatLo == -125.0f);
+
+        UTL_ListScale(ints, 0.5);
+        int first = *(int*)UTL_ListGet(ints, 0), last = *(int*)UTL_ListGetBack(ints);
+        UTL_ListScale(ints, 2.0);
+        assertPass(first == (int) (*(int*)UTL_ListGet(ints, 0) / 2));
+        assertPass(last  == (int) (*(int*)UTL_ListGetBack(ints) / 2));
+
+        UTL_ListScale(floats, -2.0);
+        assertPass(UTL_ListMin(floats, &floatLo) && floatLo == -10000.0f);
+
+        UTL_ListDestroy(ints);
+        UTL_ListDestroy(floats);
+    }
+
+    // ints out of range become INT_MIN, whether they are scaled in vector lanes or in the tail
+    UTL_List *bigInts[2] = { UTL_ListCreate(UTL_ARRAY_LIST,  &UTL_TypeInfoInt, false),
+                             UTL_ListCreate(UTL_LINKED_LIST, &UTL_TypeInfoInt, false) };
+    for (int l = 0; l < 2; l++) {
+        for (int i = 0; i < 7; i++) UTL_ListPushBack(bigInts[l], &(int) { i % 2 ? 1 << 30 : -(1 << 30) });
+        UTL_ListScale(bigInts[l], 4.0);
+        for (int i = 0; i < 7; i++) assertPass(*(int*)UTL_ListGet(bigInts[l], i) == INT_MIN);
+        UTL_ListScale(bigInts[l], NAN);
+        assertPass(*(int*)UTL_ListGetBack(bigInts[l]) == INT_MIN);
+        UTL_ListDestroy(bigInts[l]);
+    }
+
+    // pairwise summation keeps the error near float precision where plain float accumulation drifts
+    UTL_List *floats = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoFloat, false);
+    float tenth = 0.1f;
+    for (int i = 0; i < 1000000; i++) UTL_ListPushBack(floats, &tenth);
+    assertPass(fabs(UTL_ListSumPairwise(floats) - 1000000.0 * tenth) < 1e-6 * 1000000.0 * tenth);
+
+    // other data types
+    UTL_List *list = UTL_ListCreate(UTL_ARRAY_LIST, &(UTL_TypeInfo) { .size = sizeof(int) }, false);
+    int value = 3;
+    UTL_ListPushBack(list, &value);
+    assertPass(UTL_ListSum(list) == 0.0 && !UTL_ListMin(list, &value) && UTL_ListDot(list, floats) == 0.0);
+    UTL_ListDestroy(list);
+    UTL_ListDestroy(floats);
+
+    return pass;
+}
+
+static bool testListSorted(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+    UTL_List *lists[5];
+    int numLess[501] = { 0 };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        lists[t] = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+        srand(37);  // the same values for every list type
+        for (int i = 0; i < 3000; i++) {
+            int value = rand() % 500;
+            int at = UTL_ListInsertSorted(lists[t], &value);
+            assertPass(*(int*)UTL_ListGet(lists[t], at) == value);
+            assertPass(at == lists[t]->count - 1 || *(int*)UTL_ListGet(lists[t], at + 1) > value);
+        }
+        assertPass(UTL_ListIsSorted(lists[t]));
+    }
+
+    // bounds against counting, including values outside the range and missing ones
+    for (UTL_ListIter iter = UTL_ListGetIteratorFront(lists[0]); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter))
+        for (int v = *(int*)UTL_ListIterGet(&iter) + 1; v <= 500; v++) numLess[v]++;
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (int v = -1; v <= 500; v++) {
+            int lower = v < 0 ? 0 : numLess[v];
+            int upper = v < 0 ? 0 : v < 500 ? numLess[v + 1] : lists[t]->count;
+            assertPass(UTL_ListLowerBound(lists[t], &v) == lower);
+            assertPass(UTL_ListUpperBound(lists[t], &v) == upper);
+            assertPass(UTL_ListBinarySearch(lists[t], &v) == (lower < upper ? lower : -1));
+        }
+    }
+
+    // the generic search through the compare function, and the float search
+    UTL_List *byRef  = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt,   true);
+    UTL_List *floats = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoFloat, false);
+    for (UTL_ListIter iter = UTL_ListGetIteratorFront(lists[0]); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter)) {
+        float value = (float) *(int*)UTL_ListIterGet(&iter) / 2;
+        UTL_ListPushBack(byRef, UTL_ListIterGet(&iter));
+        UTL_ListPushBack(floats, &value);
+    }
+    for (int v = -1; v <= 500; v++) {
+        float half = (float) v / 2;
+        assertPass(UTL_ListLowerBound(byRef, &v)     == UTL_ListLowerBound(lists[0], &v));
+        assertPass(UTL_ListUpperBound(byRef, &v)     == UTL_ListUpperBound(lists[0], &v));
+        assertPass(UTL_ListLowerBound(floats, &half) == UTL_ListLowerBound(lists[0], &v));
+        assertPass(UTL_ListUpperBound(floats, &half) == UTL_ListUpperBound(lists[0], &v));
+    }
+
+    // merging keeps objects comparing equal in the order of their lists
+    UTL_List *merged = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, true);
+    UTL_ListMergeSorted(merged, byRef, lists[0]);
+    assertPass(merged->count == 2 * byRef->count && UTL_ListIsSorted(merged));
+
+    UTL_List *mergedK = UTL_ListCreate(UTL_TREE_LIST, &UTL_TypeInfoInt, false);
+    UTL_ListMergeSortedK(mergedK, lists, 5);
+    assertPass(mergedK->count == 5 * lists[0]->count && UTL_ListIsSorted(mergedK));
+
+    UTL_List *mergedArrays = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+    UTL_ListMergeSorted(mergedArrays, lists[0], lists[0]);
+    assertPass(mergedArrays->count == 2 * lists[0]->count && UTL_ListIsSorted(mergedArrays));
+
+    UTL_List *refs1 = UTL_ListCreate(UTL_LINKED_LIST, &UTL_TypeInfoInt, true);
+    UTL_List *refs2 = UTL_ListCreate(UTL_ARRAY_LIST,  &UTL_TypeInfoInt, true);
+    int values1[4] = { 1, 2, 2, 5 }, values2[3] = { 2, 5, 6 };
+    for (int i = 0; i < 4; i++) UTL_ListPushBack(refs1, &values1[i]);
+    for (int i = 0; i < 3; i++) UTL_ListPushBack(refs2, &values2[i]);
+    UTL_List *stable = UTL_ListCreate(UTL_DEQUE_LIST, &UTL_TypeInfoInt, true);
+    UTL_ListMergeSorted(stable, refs1, refs2);
+    int *expected[7] = { &values1[0], &values1[1], &values1[2], &values2[0], &values1[3], &values2[1], &values2[2] };
+    for (int i = 0; i < 7; i++) assertPass(UTL_ListGet(stable, i) == expected[i]);
+
+    // no compare function
+    UTL_List *list = UTL_ListCreate(UTL_ARRAY_LIST, &(UTL_TypeInfo) { .size = sizeof(int) }, false);
+    int value = 3;
+    assertPass(UTL_ListLowerBound(list, &value) == -1 && UTL_ListInsertSorted(list, &value) == -1 && list->count == 0);
+    UTL_ListDestroy(list);
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) UTL_ListDestroy(lists[t]);
+    UTL_ListDestroy(byRef);
+    UTL_ListDestroy(floats);
+    UTL_ListDestroy(merged);
+    UTL_ListDestroy(mergedK);
+    UTL_ListDestroy(mergedArrays);
+    UTL_ListDestroy(refs1);
+    UTL_ListDestroy(refs2);
+    UTL_ListDestroy(stable);
+
+    return pass;
+}
+
+static bool testListSpans(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+
+        // pushes to both ends and removals in between break up the storage
+        int64_t sum = 0;
+        for (int i = 0; i < 3000; i++) {
+            if (i % 3 == 0) UTL_ListPushFront(list, &i);
+            else            UTL_ListPushBack(list, &i);
+            sum += i;
+        }
+        for (int i = 0; i < 500; i++) {
+            sum -= *(int*)UTL_ListGet(list, i * 3);
+            UTL_ListRemove(list, i * 3);
+        }
+
+        // the spans visit the objects in list order
+        UTL_ListIter iter = UTL_ListGetIteratorFront(list);
+        int numSpans = 0;
+        for (UTL_ListSpanIter spans = UTL_ListGetSpanIter(list); UTL_ListSpanIterIsValid(&spans); UTL_ListSpanIterNext(&spans)) {
+            assertPass(spans.index == iter.index);
+            for (int i = 0; i < spans.span.count; i++) {
+                assertPass(*(int*) ((uint8_t*) spans.span.ptr + i * spans.span.stride) == *(int*)UTL_ListIterGet(&iter));
+                UTL_ListIterNext(&iter);
+            }
+            numSpans++;
+        }
+        assertPass(!UTL_ListIterIsValid(&iter));
+        assertPass(UTL_ListSum(list) == (double) sum);
+
+        UTL_Span first[2];
+        assertPass(UTL_ListGetSpans(list, first, 2) == numSpans);
+        assertPass(first[0].ptr == UTL_ListGetFront(list));
+        if (types[t] == UTL_ARRAY_LIST) assertPass(numSpans == 1);
+        if (types[t] == UTL_DEQUE_LIST) assertPass(numSpans <= 2);
+        if (types[t] == UTL_LINKED_LIST) assertPass(numSpans < list->count);
+
+        UTL_ListDestroy(list);
+    }
+
+    // empty lists have no spans, lists storing objects by reference have spans of pointers
+    int a = 1, b = 2;
+    UTL_List *list = UTL_ListCreate(UTL_LINKED_LIST, &UTL_TypeInfoInt, true);
+    UTL_ListSpanIter spans = UTL_ListGetSpanIter(list);
+    assertPass(!UTL_ListSpanIterIsValid(&spans) && UTL_ListGetSpans(list, NULL, 0) == 0);
+    UTL_ListPushBack(list, &a);
+    UTL_ListPushBack(list, &b);
+    spans = UTL_ListGetSpanIter(list);
+    assertPass(spans.span.count == 2 && *(int**) spans.span.ptr == &a && *(int**) ((uint8_t*) spans.span.ptr + spans.span.stride) == &b);
+    assertPass(UTL_ListSum(list) == 3.0);
+    UTL_ListDestroy(list);
+
+    // deques split into two spans where the objects wrap around the end of the buffer
+    list = UTL_ListCreate(UTL_DEQUE_LIST, &UTL_TypeInfoInt, false);
+    UTL_ListPushBack(list, &a);
+    UTL_ListPushFront(list, &b);
+    UTL_Span wrapped[2];
+    assertPass(UTL_ListGetSpans(list, wrapped, 2) == 2);
+    assertPass(*(int*) wrapped[0].ptr == b && wrapped[0].count == 1 && *(int*) wrapped[1].ptr == a && wrapped[1].count == 1);
+    UTL_ListDestroy(list);
+
+    return pass;
+}
+
+/* whether the objects of an array list are stored right behind its header */
+static bool isInline(UTL_List *list) {
+    uint8_t *front = UTL_ListGetFront(list);
+    return front > (uint8_t*) list && front < (uint8_t*) list + 256;
+}
+
+
+static bool testListInlineBuffer(void) {
+    bool pass = true;
+
+    UTL_List *list = UTL_ListCreateWithInlineBuffer(&UTL_TypeInfoInt, false, 8);
+
+    // the first objects are stored in the list allocation itself
+    for (int i = 0; i < 8; i++) UTL_ListPushFront(list, &i);
+    assertPass(isInline(list));
+
+    // growing beyond the inline buffer moves the objects to the heap
+    for (int i = 8; i < 100; i++) UTL_ListPushFront(list, &i);
+    assertPass(!isInline(list));
+    UTL_ListSort(list);
+    for (int i = 0; i < 100; i++) assertPass(*(int*)UTL_ListGet(list, i) == i);
+
+    // and shrinking to fit moves them back
+    UTL_ListRemoveRange(list, 5, 95);
+    UTL_ListShrinkToFit(list);
+    assertPass(isInline(list) && list->count == 5);
+    for (int i = 0; i < 5; i++) assertPass(*(int*)UTL_ListGet(list, i) == i);
+
+    UTL_ListReserve(list, 50);
+    assertPass(!isInline(list) && *(int*)UTL_ListGetBack(list) == 4);
+    UTL_ListDestroy(list);
+
+    // objects stored by reference, and lists without inline buffer
+    int values[3] = { 1, 2, 3 };
+    list = UTL_ListCreateWithInlineBuffer(&UTL_TypeInfoInt, true, 2);
+    UTL_List *plain = UTL_ListCreateWithInlineBuffer(&UTL_TypeInfoInt, true, 0);
+    for (int i = 0; i < 3; i++) {
+        UTL_ListPushBack(list,  &values[i]);
+        UTL_ListPushBack(plain, &values[i]);
+        assertPass(UTL_ListGetBack(list) == &values[i] && UTL_ListGetBack(plain) == &values[i]);
+    }
+    UTL_ListDestroy(list);
+    UTL_ListDestroy(plain);
+
+    return pass;
+}
+
+static bool testListCompact(void) {
+    bool pass = true;
+    UTL_ListNodePool *pool = UTL_ListNodePoolCreate(&UTL_TypeInfoInt, false);
+    UTL_List *lists[2] = { UTL_ListCreate(UTL_LINKED_LIST, &UTL_TypeInfoInt, false),
+                           UTL_ListCreateWithPool(&UTL_TypeInfoInt, false, pool) };
+    UTL_List *neighbour = UTL_ListCreateWithPool(&UTL_TypeInfoInt, false, pool);
+    UTL_ListNodePoolDestroy(pool);
+
+    // nodes of lists sharing a pool interleave
+    for (int i = 0; i < 1000; i++) {
+        UTL_ListPushBack(lists[1],  &i);
+        UTL_ListPushBack(neighbour, &i);
+    }
+
+    for (int l = 0; l < 2; l++) {
+        UTL_List *list = lists[l];
+        srand(41);
+        assertPass(randomEdits(list, 20000));
+        assertPass(UTL_ListFragmentation(list) > 0.5f);
+
+        int *before = malloc(sizeof(int) * list->count);
+        for (int i = 0; i < list->count; i++) before[i] = *(int*)UTL_ListGet(list, i);
+
+        assertPass(UTL_ListCompact(list, 0.1f));
+        assertPass(UTL_ListFragmentation(list) == 0.0f && !UTL_ListCompact(list, 0.1f));
+        for (int i = 0; i < list->count; i++) assertPass(*(int*)UTL_ListGet(list, i) == before[i]);
+        free(before);
+
+        // the compacted list keeps working
+        assertPass(randomEdits(list, 2000));
+    }
+
+    // the other list sharing the pool is not affected
+    assertPass(neighbour->count == 1000);
+    for (int i = 0; i < 1000; i++) assertPass(*(int*)UTL_ListGet(neighbour, i) == i);
+    UTL_ListDestroy(neighbour);
+
+    UTL_ListRemoveRange(lists[0], 0, lists[0]->count);
+    assertPass(UTL_ListCompact(lists[0], -1.0f) && lists[0]->count == 0);
+    int value = 7;
+    UTL_ListPushBack(lists[0], &value);
+    assertPass(*(int*)UTL_ListGetFront(lists[0]) == 7);
+
+    UTL_List *array = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+    assertPass(!UTL_ListCompact(array, -1.0f) && UTL_ListFragmentation(array) == 0.0f);
+
+    UTL_ListDestroy(lists[0]);
+    UTL_ListDestroy(lists[1]);
+    UTL_ListDestroy(array);
+
+    return pass;
+}
+
+static void incrementInt(void *aux, void *obj) {
+    (void) aux;
+    (*(int*) obj)++;
+}
+
+
+static bool testListIncremental(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_DEQUE_LIST, UTL_UNROLLED_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < 5; t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+
+        // random values with duplicates, with a sorted run in the middle
+        srand(48);
+        long long sum = 0;
+        for (int i = 0; i < 3000; i++) {
+            int n = i >= 1000 && i < 1500 ? i : rand() % 500;
+            sum += n;
+            UTL_ListPushBack(list, &n);
+        }
+
+        // between steps the list holds the same objects
+        UTL_ListIncremental op = { 0 };
+        int calls = 0;
+        while (!UTL_ListSortIncremental(list, &op, 500, 0)) {
+            calls++;
+            long long check = 0;
+            for (UTL_ListIter iter = UTL_ListGetIteratorFront(list); UTL_ListIterIsValid(&iter); UTL_ListIterNext(&iter))
+                check += *(int*)UTL_ListIterGet(&iter);
+            assertPass(check == sum);
+        }
+        assertPass(calls > 10 && op.auxData == NULL && op.steps > calls * 500);
+        assertPass(list->count == 3000 && UTL_ListIsSorted(list));
+
+        // a time budget, and an operation cancelled half way
+        UTL_ListIncremental timed = { 0 };
+        for (int i = 0; i < list->count; i++) UTL_ListSet(list, i, &(int) { list->count - i });
+        while (!UTL_ListSortIncremental(list, &timed, 0, 20000));
+        assertPass(UTL_ListIsSorted(list));
+
+        for (int i = 0; i < list->count; i++) UTL_ListSet(list, i, &(int) { i % 7 });
+        assertPass(!UTL_ListSortIncremental(list, &op, 100, 0));
+        UTL_ListIncrementalCancel(&op);
+        assertPass(op.auxData == NULL && list->count == 3000);
+
+        UTL_ListDestroy(list);
+    }
+
+    // compacting a linked list node by node, with a private and a shared pool
+    UTL_ListNodePool *pool = UTL_ListNodePoolCreate(&UTL_TypeInfoInt, false);
+    UTL_List *lists[2] = { UTL_ListCreate(UTL_LINKED_LIST, &UTL_TypeInfoInt, false),
+                           UTL_ListCreateWithPool(&UTL_TypeInfoInt, false, pool) };
+    UTL_ListNodePoolDestroy(pool);
+
+    for (int l = 0; l < 2; l++) {
+        UTL_List *list = lists[l];
+        srand(49);
+        assertPass(randomEdits(list, 5000));
+        assertPass(UTL_ListFragmentation(list) > 0.5f);
+
+        int *before = malloc(sizeof(int) * list->count);
+        for (int i = 0; i < list->count; i++) before[i] = *(int*)UTL_ListGet(list, i);
+
+        UTL_ListIncremental op = { 0 };
+        while (!UTL_ListCompactIncremental(list, &op, 50, 0))
+            for (int i = 0; i < list->count; i += 97) assertPass(*(int*)UTL_ListGet(list, i) == before[i]);
+        assertPass(UTL_ListFragmentation(list) == 0.0f && op.steps == list->count);
+        for (int i = 0; i < list->count; i++) assertPass(*(int*)UTL_ListGet(list, i) == before[i]);
+        free(before);
+
+        // a cancelled compaction leaves a working list
+        assertPass(!UTL_ListCompactIncremental(list, &op, 10, 0));
+        UTL_ListIncrementalCancel(&op);
+        assertPass(randomEdits(list, 2000));
+    }
+
+    UTL_List *array = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+    UTL_ListIncremental op = { 0 };
+    assertPass(UTL_ListCompactIncremental(array, &op, 1, 0) && op.auxData == NULL);
+
+    UTL_ListDestroy(lists[0]);
+    UTL_ListDestroy(lists[1]);
+    UTL_ListDestroy(array);
+    return pass;
+}
+
+
+static bool testListFiles(void) {
+    bool pass = true;
+    const char *path = "utl_list_test.bin";
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_DEQUE_LIST, UTL_UNROLLED_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < 5; t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+        for (int i = 0; i < 5000; i++) {
+            int value = i * 3;
+            if (i % 2) UTL_ListPushBack(list, &value);
+            else       UTL_ListPushFront(list, &value);
+        }
+
+        assertPass(UTL_ListSave(list, path));
+        UTL_List *mapped = UTL_ListMapFile(path, &UTL_TypeInfoInt, true);
+        assertPass(mapped && mapped->listType == UTL_ARRAY_LIST && mapped->count == list->count);
+        if (mapped) {
+            for (int i = 0; i < list->count; i++) assertPass(*(int*)UTL_ListGet(mapped, i) == *(int*)UTL_ListGet(list, i));
+            UTL_ListDestroy(mapped);
+        }
+        UTL_ListDestroy(list);
+    }
+
+    // the type has to match, not only its size
+    assertPass(!UTL_ListMapFile(path, &UTL_TypeInfoFloat, false));
+    assertPass(!UTL_ListMapFile(path, &UTL_TypeInfoChar, false));
+
+    // changing a mapped list leaves the file alone
+    UTL_List *mapped = UTL_ListMapFile(path, &UTL_TypeInfoInt, false);
+    int value = -1;
+    UTL_ListSet(mapped, 0, &value);
+    UTL_ListSort(mapped);
+    assertPass(*(int*)UTL_ListGet(mapped, 0) == -1 && UTL_ListIsSorted(mapped));
+    for (int i = 0; i < 100; i++) UTL_ListPushBack(mapped, &i);
+    assertPass(mapped->count == 5100 && *(int*)UTL_ListGetBack(mapped) == 99);
+    UTL_ListDestroy(mapped);
+
+    // the mapping is read only, so every change in place moves the objects to the heap first
+    for (int change = 0; change < 6; change++) {
+        mapped = UTL_ListMapFile(path, &UTL_TypeInfoInt, false);
+        UTL_ListIncremental op = { 0 };
+        switch (change) {
+            case 0: UTL_ListPopBack(mapped); UTL_ListPushBack(mapped, &value); break;
+            case 1: UTL_ListRemoveRange(mapped, 4000, 1000); UTL_ListPushBack(mapped, &value); break;
+            case 2: UTL_ListRemoveIf(mapped, &isMultipleOf, &(int) { 2 }); break;
+            case 3: UTL_ListScale(mapped, -1.0); break;
+            case 4: UTL_ListParallelForEach(mapped, &incrementInt, NULL, 2); break;
+            case 5: while (!UTL_ListSortIncremental(mapped, &op, 1000, 0)); break;
+        }
+        assertPass(mapped->count > 0 && mapped->count <= 5000);
+        UTL_ListDestroy(mapped);
+    }
+
+    mapped = UTL_ListMapFile(path, &UTL_TypeInfoInt, true);
+    assertPass(mapped && mapped->count == 5000 && *(int*)UTL_ListGet(mapped, 0) != -1);
+    if (mapped) UTL_ListDestroy(mapped);
+
+    // a damaged object is only noticed when verifying
+    FILE *file = fopen(path, "r+b");
+    fseek(file, -1, SEEK_END);
+    fputc(0x55, file);
+    fclose(file);
+    assertPass(!UTL_ListMapFile(path, &UTL_TypeInfoInt, true));
+    mapped = UTL_ListMapFile(path, &UTL_TypeInfoInt, false);
+    assertPass(mapped && mapped->count == 5000);
+    if (mapped) UTL_ListDestroy(mapped);
+
+    // empty lists, lists of pointers and missing files
+    UTL_List *empty = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoChar, false);
+    assertPass(UTL_ListSave(empty, path));
+    mapped = UTL_ListMapFile(path, &UTL_TypeInfoChar, true);
+    assertPass(mapped && mapped->count == 0);
+    if (mapped) {
+        char c = 'x';
+        UTL_ListPushBack(mapped, &c);
+        assertPass(*(char*)UTL_ListGetFront(mapped) == 'x');
+        UTL_ListDestroy(mapped);
+    }
+
+    UTL_List *refs = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, true);
+    assertPass(!UTL_ListSave(refs, path));
+
+    remove(path);
+    assertPass(!UTL_ListMapFile(path, &UTL_TypeInfoInt, false));
+
+    UTL_ListDestroy(empty);
+    UTL_ListDestroy(refs);
+    return pass;
+}
+
+
+#define SNAPSHOT_TEST_READERS   3
+#define SNAPSHOT_TEST_PUBLISHES 2000
+
+
+typedef struct {
+    UTL_ListSnapshotSlot *slot;
+    atomic_bool          *done;
+    int                   pins;    // number of snapshots pinned
+    bool                  intact;  // every object of every pinned snapshot was equal to its count
+} SnapshotTestReader;
+
+
+static void* snapshotReader(void *arg) {
+    SnapshotTestReader *reader = arg;
+    int lastCount = 0;
+
+    while (!atomic_load(reader->done)) {
+        UTL_ListSnapshot *snapshot = UTL_ListSnapshotPin(reader->slot);
+        if (!snapshot) continue;
+
+        // snapshots are published in order of growing size
+        reader->intact = reader->intact && snapshot->count >= lastCount;
+        UTL_Span span = UTL_ListSnapshotGetSpan(snapshot);
+        for (int i = 0; i < span.count; i++)
+            reader->intact = reader->intact && ((int*) span.ptr)[i] == snapshot->count;
+
+        lastCount = snapshot->count;
+        reader->pins++;
+        UTL_ListSnapshotRelease(snapshot);
+    }
+    return NULL;
+}
+
+
+static bool testListSnapshots(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_DEQUE_LIST, UTL_UNROLLED_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < 5; t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+        for (int i = 0; i < 3000; i++) {
+            if (i % 2) UTL_ListPushBack(list, &i);
+            else       UTL_ListPushFront(list, &i);
+        }
+
+        // the snapshot does not follow changes of the list
+        UTL_ListSnapshot *snapshot = UTL_ListFreeze(list);
+        UTL_ListRemoveRange(list, 0, 1000);
+        assertPass(snapshot->count == 3000 && !UTL_ListSnapshotGet(snapshot, 3000) && !UTL_ListSnapshotGet(snapshot, -1));
+        for (int i = 0; i < 1000; i++) assertPass(*(int*)UTL_ListSnapshotGet(snapshot, i) == 2998 - 2 * i);
+        for (int i = 0; i < list->count; i++) assertPass(*(const int*)UTL_ListSnapshotGet(snapshot, i + 1000) == *(int*)UTL_ListGet(list, i));
+
+        UTL_ListSnapshotRetain(snapshot);
+        UTL_ListSnapshotRelease(snapshot);
+        assertPass(UTL_ListSnapshotGetSpan(snapshot).count == 3000);
+        UTL_ListSnapshotRelease(snapshot);
+        UTL_ListDestroy(list);
+    }
+
+    // lists of pointers freeze the pointers
+    int values[3] = { 5, 6, 7 };
+    UTL_List *refs = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, true);
+    for (int i = 0; i < 3; i++) UTL_ListPushBack(refs, &values[i]);
+    UTL_ListSnapshot *snapshot = UTL_ListFreeze(refs);
+    assertPass(snapshot->byRef && UTL_ListSnapshotGet(snapshot, 2) == &values[2]);
+    UTL_ListSnapshotRelease(snapshot);
+    UTL_ListDestroy(refs);
+
+    // a writer publishes growing lists while readers pin whatever is current
+    UTL_ListSnapshotSlot *slot = UTL_ListSnapshotSlotCreate();
+    assertPass(UTL_ListSnapshotPin(slot) == NULL);
+
+    atomic_bool done;
+    atomic_init(&done, false);
+    pthread_t threads[SNAPSHOT_TEST_READERS];
+    SnapshotTestReader readers[SNAPSHOT_TEST_READERS];
+    for (int r = 0; r < SNAPSHOT_TEST_READERS; r++) {
+        readers[r] = (SnapshotTestReader) { .slot = slot, .done = &done, .pins = 0, .intact = true };
+        pthread_create(&threads[r], NULL, &snapshotReader, &readers[r]);
+    }
+
+    UTL_List *list = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+    for (int p = 1; p <= SNAPSHOT_TEST_PUBLISHES; p++) {
+        UTL_ListPushBack(list, &p);
+        for (int i = 0; i < list->count; i++) UTL_ListSet(list, i, &p);
+        UTL_ListSnapshotPublish(slot, UTL_ListFreeze(list));
+    }
+
+    // the last snapshot stays pinned after the slot is gone
+    UTL_ListSnapshot *last = UTL_ListSnapshotPin(slot);
+    atomic_store(&done, true);
+    for (int r = 0; r < SNAPSHOT_TEST_READERS; r++) {
+        pthread_join(threads[r], NULL);
+        assertPass(readers[r].intact);
+    }
+    UTL_ListSnapshotSlotDestroy(slot);
+
+    assertPass(last && last->count == SNAPSHOT_TEST_PUBLISHES);
+    assertPass(*(const int*)UTL_ListSnapshotGet(last, 0) == SNAPSHOT_TEST_PUBLISHES);
+    UTL_ListSnapshotRelease(last);
+
+    UTL_ListDestroy(list);
+    return pass;
+}
+
+
+static void halveInt(void *aux, void *dstObj, void *obj) {
+    (void) aux;
+    *(float*) dstObj = *(int*) obj / 2.0f;
+}
+
+
+/* sum of a run of consecutive ints, checking that the run really is consecutive */
+typedef struct {
+    int64_t sum;
+    int     first, last, count;
+    bool    consecutive;
+} IntRun;
+
+
+static void reduceIntRun(void *aux, void *state, void *obj) {
+    IntRun *run = state;
+    int value = *(int*) obj;
+    (void) aux;
+
+    if (run->count > 0 && run->last + 1 != value) run->consecutive = false;
+    if (run->count == 0) run->first = value;
+    run->last = value;
+    run->sum += value;
+    run->count++;
+}
+
+
+static void combineIntRun(void *aux, void *state, void *other) {
+    IntRun *run = state, *next = other;
+    (void) aux;
+
+    if (next->count == 0) return;
+    if (run->count > 0 && run->last + 1 != next->first) run->consecutive = false;
+    if (run->count == 0) run->first = next->first;
+    run->last         = next->last;
+    run->sum         += next->sum;
+    run->count       += next->count;
+    run->consecutive &= next->consecutive;
+}
+
+
+static bool testListParallel(void) {
+    bool pass = true;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_UNROLLED_LIST, UTL_DEQUE_LIST, UTL_TREE_LIST };
+    int sizes[] = { 100, 100003 };
+
+    for (int t = 0; t < (int)(sizeof(types) / sizeof(types[0])); t++) {
+        for (int s = 0; s < 2; s++) {
+            UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+            for (int i = 0; i < sizes[s]; i++) UTL_ListPushBack(list, &i);
+
+            UTL_ListParallelForEach(list, &incrementInt, NULL, 4);
+            IntRun run = { .consecutive = true };
+            UTL_ListParallelReduce(list, &run, sizeof(IntRun), &reduceIntRun, &combineIntRun, NULL, 4);
+            assertPass(run.consecutive && run.count == sizes[s] && run.first == 1 && run.last == sizes[s]);
+            assertPass(run.sum == (int64_t) sizes[s] * (sizes[s] + 1) / 2);
+
+            UTL_List *halves = UTL_ListCreate(types[(t + 1) % 5], &UTL_TypeInfoFloat, false);
+            float minusOne = -1.0f;
+            UTL_ListPushBack(halves, &minusOne);
+            UTL_ListParallelMap(halves, list, &halveInt, NULL, 0);
+            assertPass(halves->count == sizes[s] + 1 && *(float*)UTL_ListGetFront(halves) == -1.0f);
+            for (int i = 0; i < sizes[s]; i += 97)
+                assertPass(*(float*)UTL_ListGet(halves, i + 1) == (i + 1) / 2.0f);
+            assertPass(*(float*)UTL_ListGetBack(halves) == sizes[s] / 2.0f);
+
+            UTL_ListDestroy(list);
+            UTL_ListDestroy(halves);
+        }
+    }
+
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 
 TestFuncEntry UTL_ListTests[] = {
+    { "typedBasics",  &testTypedListBasics },
+    { "typedSort",    &testTypedListSort },
+    { "sort",         &testListSortPrimitives },
+    { "sortStable",   &testListSortStable },
+    { "sortByRef",    &testListSortByRef },
+    { "sortParallel", &testListSortParallel },
+    { "insertRemove", &testListInsertRemove },
+    { "nodePool",     &testListNodePool },
+    { "unrolled",     &testUnrolledList },
+    { "deque",        &testDequeList },
+    { "tree",         &testTreeList },
+    { "bulk",         &testListBulk },
+    { "removeIf",     &testListRemoveIf },
+    { "find",         &testListFind },
+    { "reductions",   &testListReductions },
+    { "sorted",       &testListSorted },
+    { "spans",        &testListSpans },
+    { "inlineBuffer", &testListInlineBuffer },
+    { "compact",      &testListCompact },
+    { "incremental",  &testListIncremental },
+    { "files",        &testListFiles },
+    { "snapshots",    &testListSnapshots },
+    { "parallel",     &testListParallel },
     { NULL, NULL }
-};
\ No newline at end of file
+};
@@ -0,0 +1,149 @@
+#include "utl_priorityqueue.h"
+#include "UTL/UTL.h"
+
+
+/* pop all objects of an int queue, checking that they come out in order. returns the number of popped objects */
+static int popAllSorted(UTL_PriorityQueue *queue, bool *sorted) {
+    int count = 0, prev = INT_MIN, value;
+    *sorted = true;
+
+    while (UTL_PriorityQueuePop(queue, &value)) {
+        if (value < prev) *sorted = false;
+        prev = value;
+        count++;
+    }
+
+    return count;
+}
+
+
+static bool testPriorityQueueBasics(void) {
+    bool pass = true, sorted;
+    UTL_PriorityQueue *queue = UTL_PriorityQueueCreate(&UTL_TypeInfoInt, false);
+
+    int value;
+    assertPass(!UTL_PriorityQueuePop(queue, &value) && UTL_PriorityQueuePeek(queue) == NULL);
+    assertPass(UTL_PriorityQueuePeekHandle(queue) == -1);
+
+    srand(45);
+    int min = INT_MAX;
+    for (int i = 0; i < 1000; i++) {
+        value = rand() % 500;
+        if (value < min) min = value;
+        assertPass(UTL_PriorityQueuePush(queue, &value) == i);
+        assertPass(*(int*) UTL_PriorityQueuePeek(queue) == min);
+    }
+    assertPass(queue->count == 1000);
+
+    assertPass(popAllSorted(queue, &sorted) == 1000 && sorted);
+    assertPass(queue->count == 0);
+
+    // interleaved pushes and pops reuse handles
+    for (int i = 0; i < 100; i++) {
+        value = 100 - i;
+        int handle = UTL_PriorityQueuePush(queue, &value);
+        assertPass(handle >= 0 && handle < 1000);
+        if (i % 3 == 0) assertPass(UTL_PriorityQueuePop(queue, NULL));
+    }
+    assertPass(popAllSorted(queue, &sorted) == 66 && sorted);
+
+    UTL_PriorityQueueDestroy(queue);
+    return pass;
+}
+
+
+static bool testPriorityQueueHandles(void) {
+    bool pass = true, sorted;
+    UTL_PriorityQueue *queue = UTL_PriorityQueueCreate(&UTL_TypeInfoInt, false);
+
+    int handles[200];
+    for (int i = 0; i < 200; i++) {
+        int value = 1000 + i;
+        handles[i] = UTL_PriorityQueuePush(queue, &value);
+    }
+
+    // decrease key
+    int value = 5;
+    assertPass(UTL_PriorityQueueUpdate(queue, handles[150], &value));
+    assertPass(UTL_PriorityQueuePeekHandle(queue) == handles[150] && *(int*) UTL_PriorityQueuePeek(queue) == 5);
+
+    // increase key
+    value = 5000;
+    assertPass(UTL_PriorityQueueUpdate(queue, handles[150], &value));
+    assertPass(*(int*) UTL_PriorityQueuePeek(queue) == 1000);
+    assertPass(*(int*) UTL_PriorityQueueGet(queue, handles[150]) == 5000);
+
+    for (int i = 0; i < 200; i += 2) assertPass(UTL_PriorityQueueRemove(queue, handles[i]));
+    assertPass(!UTL_PriorityQueueRemove(queue, handles[0]) && !UTL_PriorityQueueContains(queue, handles[0]));
+    assertPass(UTL_PriorityQueueGet(queue, handles[0]) == NULL && UTL_PriorityQueueGet(queue, 1000) == NULL);
+    assertPass(!UTL_PriorityQueueUpdate(queue, handles[0], &value));
+    assertPass(queue->count == 100);
+
+    for (int i = 1; i < 200; i += 2) {
+        assertPass(UTL_PriorityQueueContains(queue, handles[i]));
+        assertPass(*(int*) UTL_PriorityQueueGet(queue, handles[i]) == 1000 + i);
+    }
+
+    assertPass(UTL_PriorityQueuePeekHandle(queue) == handles[1]);
+    assertPass(popAllSorted(queue, &sorted) == 100 && sorted);
+
+    // objects stored by reference
+    UTL_PriorityQueueDestroy(queue);
+    queue = UTL_PriorityQueueCreate(&UTL_TypeInfoInt, true);
+
+    int values[4] = { 30, 10, 40, 20 };
+    for (int i = 0; i < 4; i++) UTL_PriorityQueuePush(queue, &values[i]);
+    assertPass(UTL_PriorityQueuePeek(queue) == &values[1]);
+
+    int *ptr;
+    assertPass(UTL_PriorityQueuePop(queue, &ptr) && ptr == &values[1]);
+    assertPass(UTL_PriorityQueuePop(queue, &ptr) && ptr == &values[3]);
+
+    UTL_PriorityQueueDestroy(queue);
+    return pass;
+}
+
+
+static bool testPriorityQueueFromList(void) {
+    bool pass = true, sorted;
+    UTL_ListType types[] = { UTL_ARRAY_LIST, UTL_LINKED_LIST, UTL_DEQUE_LIST, UTL_UNROLLED_LIST, UTL_TREE_LIST };
+
+    for (int t = 0; t < 5; t++) {
+        UTL_List *list = UTL_ListCreate(types[t], &UTL_TypeInfoInt, false);
+        srand(45);
+        for (int i = 0; i < 5000; i++) {
+            int value = rand();
+            UTL_ListPushBack(list, &value);
+        }
+
+        UTL_PriorityQueue *queue = UTL_PriorityQueueCreateFromList(list);
+        assertPass(queue->count == 5000);
+
+        for (int i = 0; i < 5000; i += 97)
+            assertPass(*(int*) UTL_PriorityQueueGet(queue, i) == *(int*) UTL_ListGet(list, i));
+
+        assertPass(popAllSorted(queue, &sorted) == 5000 && sorted);
+
+        UTL_PriorityQueueDestroy(queue);
+        UTL_ListDestroy(list);
+    }
+
+    UTL_List *empty = UTL_ListCreate(UTL_ARRAY_LIST, &UTL_TypeInfoInt, false);
+    UTL_PriorityQueue *queue = UTL_PriorityQueueCreateFromList(empty);
+    assertPass(queue->count == 0 && UTL_PriorityQueuePeek(queue) == NULL);
+    UTL_PriorityQueueDestroy(queue);
+    UTL_ListDestroy(empty);
+
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TestFuncEntry UTL_PriorityQueueTests[] = {
+    { "basics",   &testPriorityQueueBasics },
+    { "handles",  &testPriorityQueueHandles },
+    { "fromList", &testPriorityQueueFromList },
+    { NULL, NULL }
+};
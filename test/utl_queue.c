@@ -0,0 +1,137 @@
+#include "utl_queue.h"
+#include "UTL/UTL.h"
+#include <pthread.h>
+
+
+static bool testQueueBasics(void) {
+    bool pass = true;
+    UTL_Queue *queue = UTL_QueueCreate(&UTL_TypeInfoInt, false, 5);
+    assertPass(queue->capacity == 8);
+
+    int value;
+    assertPass(!UTL_QueueTryPop(queue, &value));
+
+    // fill and drain a few rounds, so positions wrap around the ring
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 8; i++) assertPass(UTL_QueueTryPush(queue, &i));
+        assertPass(!UTL_QueueTryPush(queue, &value) && UTL_QueueCount(queue) == 8);
+
+        for (int i = 0; i < 8; i++) assertPass(UTL_QueueTryPop(queue, &value) && value == i);
+        assertPass(!UTL_QueueTryPop(queue, &value) && UTL_QueueCount(queue) == 0);
+    }
+
+    // batches stop at a full or empty queue
+    int values[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }, popped[12];
+    assertPass(UTL_QueueTryPushN(queue, values, 3) == 3);
+    assertPass(UTL_QueueTryPushN(queue, values + 3, 9) == 5);
+    assertPass(UTL_QueueTryPopN(queue, popped, 6) == 6);
+    assertPass(UTL_QueueTryPushN(queue, values + 8, 4) == 4);
+    assertPass(UTL_QueueTryPopN(queue, popped + 6, 12) == 6);
+    for (int i = 0; i < 12; i++) assertPass(popped[i] == i);
+
+    UTL_QueueDestroy(queue);
+
+    // objects stored by reference
+    queue = UTL_QueueCreate(&UTL_TypeInfoInt, true, 4);
+    int *ptr;
+    assertPass(UTL_QueueTryPush(queue, &values[5]) && UTL_QueueTryPop(queue, &ptr) && ptr == &values[5]);
+    int *ptrs[2] = { &values[1], &values[2] };
+    assertPass(UTL_QueueTryPushN(queue, ptrs, 2) == 2 && UTL_QueueTryPop(queue, &ptr) && ptr == &values[1]);
+    UTL_QueueDestroy(queue);
+
+    return pass;
+}
+
+
+#define QUEUE_TEST_THREADS 4
+#define QUEUE_TEST_VALUES  40000
+
+
+typedef struct {
+    UTL_Queue *queue;
+    int        thread;
+    int64_t    sum;     // consumers: sum of all popped values
+    int        count;   // consumers: number of popped values
+    bool       ordered; // consumers: values of each producer were popped in the order they were pushed
+} QueueTestThread;
+
+
+/* producer @thread pushes thread, thread + QUEUE_TEST_THREADS, thread + 2 * QUEUE_TEST_THREADS, .. */
+static void* queueProducer(void *arg) {
+    QueueTestThread *t = arg;
+
+    for (int value = t->thread; value < QUEUE_TEST_VALUES; ) {
+        if (t->thread % 2 == 0) {
+            if (UTL_QueueTryPush(t->queue, &value)) value += QUEUE_TEST_THREADS;
+        }
+        else {
+            int batch[8], n = 0;
+            for (int v = value; v < QUEUE_TEST_VALUES && n < 8; v += QUEUE_TEST_THREADS) batch[n++] = v;
+            value += QUEUE_TEST_THREADS * UTL_QueueTryPushN(t->queue, batch, n);
+        }
+    }
+
+    return NULL;
+}
+
+
+static void* queueConsumer(void *arg) {
+    QueueTestThread *t = arg;
+    int last[QUEUE_TEST_THREADS];
+    for (int p = 0; p < QUEUE_TEST_THREADS; p++) last[p] = -1;
+
+    while (t->count < QUEUE_TEST_VALUES / QUEUE_TEST_THREADS) {
+        int values[4];
+        int n = UTL_QueueTryPopN(t->queue, values, QUEUE_TEST_VALUES / QUEUE_TEST_THREADS - t->count < 4 ? 1 : 4);
+        for (int i = 0; i < n; i++) {
+            int producer = values[i] % QUEUE_TEST_THREADS;
+            if (values[i] <= last[producer]) t->ordered = false;
+            last[producer] = values[i];
+            t->sum += values[i];
+        }
+        t->count += n;
+    }
+
+    return NULL;
+}
+
+
+static bool testQueueThreads(void) {
+    bool pass = true;
+    UTL_Queue *queue = UTL_QueueCreate(&UTL_TypeInfoInt, false, 64);
+
+    pthread_t producers[QUEUE_TEST_THREADS], consumers[QUEUE_TEST_THREADS];
+    QueueTestThread producerData[QUEUE_TEST_THREADS], consumerData[QUEUE_TEST_THREADS];
+
+    for (int i = 0; i < QUEUE_TEST_THREADS; i++) {
+        producerData[i] = (QueueTestThread) { .queue = queue, .thread = i };
+        consumerData[i] = (QueueTestThread) { .queue = queue, .thread = i, .ordered = true };
+        pthread_create(&producers[i], NULL, &queueProducer, &producerData[i]);
+        pthread_create(&consumers[i], NULL, &queueConsumer, &consumerData[i]);
+    }
+
+    int64_t sum = 0;
+    for (int i = 0; i < QUEUE_TEST_THREADS; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        sum += consumerData[i].sum;
+        assertPass(consumerData[i].ordered);
+    }
+
+    // every value was popped exactly once
+    assertPass(sum == (int64_t) QUEUE_TEST_VALUES * (QUEUE_TEST_VALUES - 1) / 2);
+    assertPass(UTL_QueueCount(queue) == 0);
+
+    UTL_QueueDestroy(queue);
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TestFuncEntry UTL_QueueTests[] = {
+    { "basics",  &testQueueBasics },
+    { "threads", &testQueueThreads },
+    { NULL, NULL }
+};
@@ -0,0 +1,103 @@
+#include "utl_slotmap.h"
+#include "UTL/UTL.h"
+
+
+static bool testSlotMapHandles(void) {
+    bool pass = true;
+    UTL_SlotMap *map = UTL_SlotMapCreate(&UTL_TypeInfoInt);
+
+    UTL_SlotHandle zero = { 0, 0 };
+    assertPass(map->count == 0 && UTL_SlotMapGet(map, zero) == NULL && !UTL_SlotMapRemove(map, zero));
+
+    UTL_SlotHandle handles[100];
+    for (int i = 0; i < 100; i++) handles[i] = UTL_SlotMapInsert(map, &i);
+    assertPass(map->count == 100);
+    for (int i = 0; i < 100; i++) assertPass(*(int*) UTL_SlotMapGet(map, handles[i]) == i);
+
+    // handles stay valid while other objects are removed
+    for (int i = 0; i < 100; i += 3) assertPass(UTL_SlotMapRemove(map, handles[i]));
+    assertPass(map->count == 66 && !UTL_SlotMapRemove(map, handles[0]));
+    for (int i = 0; i < 100; i++) {
+        bool removed = i % 3 == 0;
+        assertPass(UTL_SlotMapContains(map, handles[i]) != removed);
+        assertPass(removed ? UTL_SlotMapGet(map, handles[i]) == NULL : *(int*) UTL_SlotMapGet(map, handles[i]) == i);
+    }
+
+    // reused slots get a new generation, so old handles stay invalid
+    UTL_SlotHandle reused[34];
+    for (int i = 0; i < 34; i++) {
+        int value = 1000 + i;
+        reused[i] = UTL_SlotMapInsert(map, &value);
+        assertPass(reused[i].index < 100);
+    }
+    for (int i = 0; i < 100; i += 3) assertPass(UTL_SlotMapGet(map, handles[i]) == NULL);
+    for (int i = 0; i < 34; i++) assertPass(*(int*) UTL_SlotMapGet(map, reused[i]) == 1000 + i);
+
+    // free slots do not answer to the generation they will have next
+    assertPass(UTL_SlotMapRemove(map, reused[0]));
+    UTL_SlotHandle next = { reused[0].index, reused[0].generation + 1 };
+    assertPass(UTL_SlotMapGet(map, next) == NULL);
+    assertPass(UTL_SlotMapGet(map, (UTL_SlotHandle) { 500, 1 }) == NULL);
+
+    UTL_SlotMapClear(map);
+    assertPass(map->count == 0);
+    for (int i = 1; i < 100; i += 3) assertPass(UTL_SlotMapGet(map, handles[i]) == NULL);
+
+    int value = 7;
+    UTL_SlotHandle handle = UTL_SlotMapInsert(map, &value);
+    assertPass(*(int*) UTL_SlotMapGet(map, handle) == 7 && map->count == 1);
+
+    UTL_SlotMapDestroy(map);
+    return pass;
+}
+
+
+static bool testSlotMapSpan(void) {
+    bool pass = true;
+    UTL_SlotMap *map = UTL_SlotMapCreate(&UTL_TypeInfoFloat);
+    UTL_SlotMapReserve(map, 1000);
+
+    UTL_SlotHandle handles[1000];
+    for (int i = 0; i < 1000; i++) {
+        float value = (float) i;
+        handles[i] = UTL_SlotMapInsert(map, &value);
+    }
+
+    srand(47);
+    int removed = 0;
+    for (int i = 0; i < 1000; i++)
+        if (rand() % 2 && UTL_SlotMapRemove(map, handles[i])) removed++;
+    assertPass(map->count == 1000 - removed);
+
+    // the dense array holds exactly the remaining objects, each knowing its handle
+    UTL_Span span = UTL_SlotMapGetSpan(map);
+    assertPass(span.count == map->count && span.stride == sizeof(float));
+
+    double sum = 0, expected = 0;
+    for (int at = 0; at < span.count; at++) {
+        float *obj = (float*) ((uint8_t*) span.ptr + span.stride * at);
+        UTL_SlotHandle handle = UTL_SlotMapHandleAt(map, at);
+        assertPass(UTL_SlotMapGet(map, handle) == obj);
+        assertPass(handle.index == handles[(int) *obj].index && handle.generation == handles[(int) *obj].generation);
+        sum += *obj;
+    }
+    for (int i = 0; i < 1000; i++)
+        if (UTL_SlotMapContains(map, handles[i])) expected += i;
+    assertPass(sum == expected);
+
+    UTL_SlotHandle none = UTL_SlotMapHandleAt(map, span.count);
+    assertPass(none.index == 0 && none.generation == 0);
+
+    UTL_SlotMapDestroy(map);
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TestFuncEntry UTL_SlotMapTests[] = {
+    { "handles", &testSlotMapHandles },
+    { "span",    &testSlotMapSpan },
+    { NULL, NULL }
+};
@@ -0,0 +1,120 @@
+#include "utl_soalist.h"
+#include "UTL/UTL.h"
+
+
+typedef struct {
+    float pos[3];
+    char  flag;
+    int   id;
+    double mass;
+} SoATestParticle;
+
+
+static UTL_SoAList* createParticleList(void) {
+    UTL_SoAField fields[] = {
+        UTL_SoAFieldOf(SoATestParticle, pos),
+        UTL_SoAFieldOf(SoATestParticle, flag),
+        UTL_SoAFieldOf(SoATestParticle, id),
+        UTL_SoAFieldOf(SoATestParticle, mass)
+    };
+    return UTL_SoAListCreate(fields, 4, sizeof(SoATestParticle));
+}
+
+
+static SoATestParticle particle(int id) {
+    return (SoATestParticle) { .pos = { id, id * 2, id * 3 }, .flag = (char) (id % 2), .id = id, .mass = id * 0.5 };
+}
+
+
+static bool sameParticle(SoATestParticle *p, int id) {
+    SoATestParticle q = particle(id);
+    return p->id == q.id && p->flag == q.flag && p->mass == q.mass &&
+           p->pos[0] == q.pos[0] && p->pos[1] == q.pos[1] && p->pos[2] == q.pos[2];
+}
+
+
+static bool testSoAListRecords(void) {
+    bool pass = true;
+    UTL_SoAList *list = createParticleList();
+    assertPass(list->numFields == 4 && list->recordSize == sizeof(SoATestParticle) && list->count == 0);
+
+    SoATestParticle p;
+    assertPass(!UTL_SoAListGet(list, 0, &p) && UTL_SoAListGetField(list, 0, 0) == NULL);
+
+    for (int i = 0; i < 100; i++) {
+        p = particle(i);
+        UTL_SoAListPushBack(list, &p);
+    }
+    assertPass(list->count == 100);
+
+    for (int i = 0; i < 100; i++) assertPass(UTL_SoAListGet(list, i, &p) && sameParticle(&p, i));
+    assertPass(!UTL_SoAListGet(list, 100, &p) && !UTL_SoAListGet(list, -1, &p));
+    assertPass(*(int*) UTL_SoAListGetField(list, 42, 2) == 42 && UTL_SoAListGetField(list, 42, 4) == NULL);
+
+    p = particle(1000);
+    UTL_SoAListSet(list, 7, &p);
+    assertPass(UTL_SoAListGet(list, 7, &p) && sameParticle(&p, 1000));
+
+    // swap remove moves the last record into the gap
+    UTL_SoAListSwapRemove(list, 7);
+    assertPass(list->count == 99 && UTL_SoAListGet(list, 7, &p) && sameParticle(&p, 99));
+    UTL_SoAListSwapRemove(list, 98);
+    assertPass(list->count == 98 && UTL_SoAListGet(list, 97, &p) && sameParticle(&p, 97));
+
+    UTL_SoAListPopBack(list);
+    assertPass(list->count == 97);
+    UTL_SoAListClear(list);
+    assertPass(list->count == 0);
+    UTL_SoAListPopBack(list);
+    assertPass(list->count == 0);
+
+    UTL_SoAListDestroy(list);
+    return pass;
+}
+
+
+static bool testSoAListColumns(void) {
+    bool pass = true;
+    UTL_SoAList *list = createParticleList();
+
+    UTL_SoAListReserve(list, 1000);
+    for (int i = 0; i < 1000; i++) {
+        SoATestParticle p = particle(i);
+        UTL_SoAListPushBack(list, &p);
+    }
+
+    for (int f = 0; f < 4; f++) {
+        UTL_Span column = UTL_SoAListGetColumn(list, f);
+        assertPass(column.count == 1000 && (uintptr_t) column.ptr % 64 == 0);
+    }
+
+    UTL_Span ids = UTL_SoAListGetColumn(list, 2);
+    assertPass(ids.stride == sizeof(int));
+    for (int i = 0; i < ids.count; i++) assertPass(((int*) ids.ptr)[i] == i);
+
+    // pass over one field only
+    UTL_Span masses = UTL_SoAListGetColumn(list, 3);
+    for (int i = 0; i < masses.count; i++) ((double*) masses.ptr)[i] *= 2;
+
+    UTL_Span positions = UTL_SoAListGetColumn(list, 0);
+    assertPass(positions.stride == 3 * sizeof(float));
+    assertPass(((float*) positions.ptr)[3 * 10 + 2] == 30);
+
+    SoATestParticle p;
+    assertPass(UTL_SoAListGet(list, 10, &p) && p.mass == 10 && p.id == 10);
+
+    assertPass(UTL_SoAListGetColumn(list, 4).ptr == NULL);
+
+    UTL_SoAListDestroy(list);
+    return pass;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+TestFuncEntry UTL_SoAListTests[] = {
+    { "records", &testSoAListRecords },
+    { "columns", &testSoAListColumns },
+    { NULL, NULL }
+};